@@ -9,47 +9,144 @@
 ====================================================*/
 
 #pragma once
-#include <cassert>
+#include <compare>
 #include <concepts>
 #include <cstddef>
-#include <functional>
+#include <exception>
 #include <new>
-#include <optional>
 #include <type_traits>
 #include <utility>
+// CPP_PROPERTY_MINIMAL_INCLUDE skips <functional>, which is only needed for std::invoke of member pointers,
+// to reduce the parse time of every includer
+#ifndef CPP_PROPERTY_MINIMAL_INCLUDE
+#include <functional>
+#endif
+
+// the internal namespace has internal linkage, except in the module interface which has to export it
+#ifdef CPP_PROPERTY_MODULE_INTERFACE
+#define CPP_PROPERTY_INTERNAL_NAMESPACE inline namespace internal
+#else
+#define CPP_PROPERTY_INTERNAL_NAMESPACE namespace
+#endif
 
 namespace cpp_property
 {
-    namespace  // NOLINT
+    // thrown by calling an accessor which is not set
+    struct bad_accessor_call : std::exception
+    {
+        [[nodiscard]] const char* what() const noexcept override { return "cpp_property: empty accessor"; }
+    };
+
+    CPP_PROPERTY_INTERNAL_NAMESPACE  // NOLINT
     {
         namespace detail
         {
+            template <typename T>
+            [[nodiscard]] constexpr T* addressof(T& value) noexcept
+            {
+                return __builtin_addressof(value);
+            }
+            template <typename Func, typename... As>
+            constexpr decltype(auto) invoke(Func&& func, As&&... args)
+            {
+#ifdef CPP_PROPERTY_MINIMAL_INCLUDE
+                return std::forward<Func>(func)(std::forward<As>(args)...);
+#else
+                return std::invoke(std::forward<Func>(func), std::forward<As>(args)...);
+#endif
+            }
+
+            template <typename... Ts>
+            struct type_list
+            {
+                static constexpr std::size_t size = sizeof...(Ts);
+            };
+            template <typename List>
+            struct first_type;
+            template <typename T, typename... Ts>
+            struct first_type<type_list<T, Ts...>>
+            {
+                using type = T;
+            };
+
+            // signature deduction of the std::function deduction guides: function pointers and classes with
+            // a single non-template operator()
+            template <typename T>
+            struct signature_of
+            {
+            };
+            template <typename R, typename... As>
+            struct signature_of<R(As...)>
+            {
+                using return_type = R;
+                using argument_types = type_list<As...>;
+            };
+            template <typename R, typename... As>
+            struct signature_of<R(As...) noexcept> : signature_of<R(As...)>
+            {
+            };
+            template <typename R, typename... As>
+            struct signature_of<R (*)(As...)> : signature_of<R(As...)>
+            {
+            };
+            template <typename R, typename... As>
+            struct signature_of<R (*)(As...) noexcept> : signature_of<R(As...)>
+            {
+            };
+#define CPP_PROPERTY_CALL_OPERATOR_SIGNATURE(QUALIFIERS)                     \
+    template <typename R, typename C, typename... As>                        \
+    struct signature_of<R (C::*)(As...) QUALIFIERS> : signature_of<R(As...)> \
+    {                                                                        \
+    };
+#define CPP_PROPERTY_CALL_OPERATOR_SIGNATURES(CV)      \
+    CPP_PROPERTY_CALL_OPERATOR_SIGNATURE(CV)           \
+    CPP_PROPERTY_CALL_OPERATOR_SIGNATURE(CV&)          \
+    CPP_PROPERTY_CALL_OPERATOR_SIGNATURE(CV&&)         \
+    CPP_PROPERTY_CALL_OPERATOR_SIGNATURE(CV noexcept)  \
+    CPP_PROPERTY_CALL_OPERATOR_SIGNATURE(CV& noexcept) \
+    CPP_PROPERTY_CALL_OPERATOR_SIGNATURE(CV&& noexcept)
+            CPP_PROPERTY_CALL_OPERATOR_SIGNATURES()
+            CPP_PROPERTY_CALL_OPERATOR_SIGNATURES(const)
+            CPP_PROPERTY_CALL_OPERATOR_SIGNATURES(volatile)
+            CPP_PROPERTY_CALL_OPERATOR_SIGNATURES(const volatile)
+#undef CPP_PROPERTY_CALL_OPERATOR_SIGNATURES
+#undef CPP_PROPERTY_CALL_OPERATOR_SIGNATURE
+
+            template <typename F>
+            struct callable_signature : signature_of<F>
+            {
+            };
+            template <typename F>
+            requires std::is_class_v<F> && requires { &F::operator(); }
+            struct callable_signature<F> : signature_of<decltype(&F::operator())>
+            {
+            };
+
             template <typename Func>
-            concept function_castable = requires(Func f) { std::function{f}; };
+            concept function_castable = std::copy_constructible<std::decay_t<Func>> && requires {
+                typename callable_signature<std::decay_t<Func>>::return_type;
+            };
 
             template <function_castable T>
             class function_traits
             {
-                template <typename R, typename... As>
-                static std::tuple<As...> args(std::function<R(As...)>);
-                template <typename R, typename... As>
-                static R result(std::function<R(As...)>);
+                using signature = callable_signature<std::decay_t<T>>;
 
             public:
-                using return_type = decltype(result(std::function{std::declval<T>()}));
-                using argument_types = decltype(args(std::function{std::declval<T>()}));
+                using return_type = typename signature::return_type;
+                using argument_types = typename signature::argument_types;
             };
 
             template <typename Func>
             concept getter_function = function_castable<Func> && requires {
                 requires (!std::same_as<void, typename function_traits<Func>::return_type>) &&
-                             (std::tuple_size_v<typename function_traits<Func>::argument_types> == 0);
+                             (function_traits<Func>::argument_types::size == 0);
             };
 
             template <typename Func>
             concept setter_function = function_castable<Func> && requires {
                 requires std::same_as<void, typename function_traits<Func>::return_type> &&
-                             (std::tuple_size_v<typename function_traits<Func>::argument_types> == 1);
+                             (function_traits<Func>::argument_types::size == 1);
             };
 
             template <typename OuterReturnType, typename InnerReturnType>
@@ -62,19 +159,27 @@ namespace cpp_property
             template <typename R, typename... As, std::size_t StorageSize>
             class small_function<R(As...), StorageSize>
             {
-                using Storage = std::aligned_storage_t<StorageSize, alignof(void*)>;
-
-                Storage storage_;
+                // left uninitialized at run time (it is only used for placement new); zeroed by the constructors in
+                // constant evaluation, where every byte of a constexpr object must be initialized
+                alignas(void*) std::byte storage_[StorageSize];  // NOLINT
                 void* entity_ = nullptr;
                 R (*invoke_)(void*, As&&...) = nullptr;
                 void (*destroy_)(void*) noexcept = nullptr;
 
                 template <typename Func>
                 static constexpr auto can_store_inline =
-                    sizeof(Func) <= StorageSize && alignof(Func) <= alignof(Storage);
+                    sizeof(Func) <= StorageSize && alignof(Func) <= alignof(void*);
+
+                constexpr void zero_storage() noexcept
+                {
+                    for (auto& b : storage_) b = std::byte{};
+                }
 
             public:
-                small_function() noexcept {}
+                constexpr small_function() noexcept  // NOLINT
+                {
+                    if (std::is_constant_evaluated()) zero_storage();
+                }
                 small_function(const small_function&) = delete;
                 small_function(small_function&&) = delete;
                 small_function& operator=(const small_function&) = delete;
@@ -85,12 +190,13 @@ namespace cpp_property
                          std::invocable<std::remove_cvref_t<Func>&, As...> &&
                          (std::is_void_v<R> ||
                           std::convertible_to<std::invoke_result_t<std::remove_cvref_t<Func>&, As...>, R>)
-                small_function(Func&& func)
+                constexpr small_function(Func&& func)  // NOLINT
                 {
+                    if (std::is_constant_evaluated()) zero_storage();
                     using Function = std::remove_cvref_t<Func>;
                     if constexpr (can_store_inline<Function>)
                     {
-                        entity_ = ::new (static_cast<void*>(&storage_)) Function(std::forward<Func>(func));
+                        entity_ = ::new (static_cast<void*>(storage_)) Function(std::forward<Func>(func));
                         destroy_ = [](void* entity) noexcept { static_cast<Function*>(entity)->~Function(); };
                     }
                     else
@@ -102,33 +208,69 @@ namespace cpp_property
                     invoke_ = [](void* entity, As&&... args) -> R {
                         if constexpr (std::is_void_v<R>)
                         {
-                            std::invoke(*static_cast<Function*>(entity), std::forward<As>(args)...);
+                            detail::invoke(*static_cast<Function*>(entity), std::forward<As>(args)...);
                         }
                         else
                         {
-                            return std::invoke(*static_cast<Function*>(entity), std::forward<As>(args)...);
+                            return detail::invoke(*static_cast<Function*>(entity), std::forward<As>(args)...);
                         }
                     };
                 }
 
-                ~small_function()
+                constexpr ~small_function()
                 {
                     if (destroy_) destroy_(entity_);
                 }
 
-                explicit operator bool() const noexcept { return invoke_ != nullptr; }
+                constexpr explicit operator bool() const noexcept { return invoke_ != nullptr; }
 
-                R operator()(As... args) const
+                constexpr R operator()(As... args) const
                 {
-                    if (!invoke_) throw std::bad_function_call();
+                    if (!invoke_) throw bad_accessor_call();
                     return invoke_(entity_, std::forward<As>(args)...);
                 }
             };
 
             template <setter_function Func>
-            using setter_argument_type = std::tuple_element_t<0, typename function_traits<Func>::argument_types>;
+            using setter_argument_type = typename first_type<typename function_traits<Func>::argument_types>::type;
             template <getter_function Func>
             using getter_return_type = typename function_traits<Func>::return_type;
+            template <function_castable Func>
+            using indexer_signature = typename function_traits<Func>::return_type(
+                typename first_type<typename function_traits<Func>::argument_types>::type);
+
+            // non-owning reference to a callable which mutates a value in place
+            template <typename T>
+            class mutator
+            {
+                void* callable_;
+                void (*invoke_)(void*, T&);
+
+            public:
+                template <typename Func>
+                requires (!std::same_as<std::remove_cvref_t<Func>, mutator>) && std::invocable<Func&, T&>
+                mutator(Func& func) noexcept  // NOLINT
+                    : callable_(const_cast<void*>(static_cast<const void*>(detail::addressof(func)))),
+                      invoke_([](void* callable, T& value) {
+                          detail::invoke(*static_cast<std::remove_reference_t<Func>*>(callable), value);
+                      })
+                {
+                }
+                void operator()(T& value) const { invoke_(callable_, value); }
+            };
+
+            // types whose operator-> can be forwarded as is: pointers and classes defining operator->
+            template <typename T>
+            concept arrow_forwardable =
+                std::is_pointer_v<std::remove_cvref_t<T>> || requires(T&& v) { std::forward<T>(v).operator->(); };
+
+            // holds a by-value getter result for the duration of member access through operator->
+            template <typename T>
+            struct arrow_proxy
+            {
+                T value;
+                [[nodiscard]] constexpr const T* operator->() const noexcept { return detail::addressof(value); }
+            };
 
             template <typename, typename, typename>
             class property_base;
@@ -143,12 +285,12 @@ namespace cpp_property
             template <typename DerivedType, typename ReturnType, typename ArgumentType>
             class property_base
             {
-                [[nodiscard]] const DerivedType& derived() const& noexcept
+                [[nodiscard]] constexpr const DerivedType& derived() const& noexcept
                 {
                     return static_cast<const DerivedType&>(*this);
                 }
-                DerivedType& derived() & noexcept { return static_cast<DerivedType&>(*this); }
-                DerivedType&& derived() && noexcept { return static_cast<DerivedType&&>(*this); }
+                constexpr DerivedType& derived() & noexcept { return static_cast<DerivedType&>(*this); }
+                constexpr DerivedType&& derived() && noexcept { return static_cast<DerivedType&&>(*this); }
 
                 static constexpr auto has_getter = !std::same_as<void, ReturnType>;
                 static constexpr auto has_setter = !std::same_as<void, ArgumentType>;
@@ -163,28 +305,33 @@ namespace cpp_property
                 property_base& operator=(property_base&&) = delete;
 
                 // explicit cast
-                ReturnType operator()() const
+                constexpr ReturnType operator()() const
                 requires has_getter
                 {
                     return derived().get();
                 }
 
                 // implicit cast
-                operator ReturnType() const  // NOLINT
+                constexpr operator ReturnType() const  // NOLINT
                 requires has_getter
                 {
                     return derived().get();
                 }
 
-                // arrow operator
-                ReturnType operator->() const
+                // arrow operator (member access of class types without copying referenced values)
+                constexpr decltype(auto) operator->() const
                 requires has_getter
                 {
-                    return derived().get();
+                    if constexpr (arrow_forwardable<ReturnType> || !std::is_class_v<std::remove_cvref_t<ReturnType>>)
+                        return derived().get();
+                    else if constexpr (std::is_lvalue_reference_v<ReturnType>)
+                        return detail::addressof(derived().get());
+                    else
+                        return arrow_proxy<std::remove_cv_t<ReturnType>>{derived().get()};
                 }
 
                 // indirection operator
-                decltype(auto) operator*() const
+                constexpr decltype(auto) operator*() const
                 requires has_getter && requires(ReturnType v) { *v; }
                 {
                     return *derived().get();
@@ -193,7 +340,7 @@ namespace cpp_property
                 // equal operator (default)
                 template <typename U>
                 requires has_setter
-                decltype(auto) operator=(U&& value) const
+                constexpr decltype(auto) operator=(U&& value) const
                 {
                     U right = value;
                     derived().set(std::forward<U>(value));
@@ -201,60 +348,78 @@ namespace cpp_property
                 }
                 template <typename U>
                 requires has_setter
-                decltype(auto) operator=(U&& value)
+                constexpr decltype(auto) operator=(U&& value)
                 {
                     U right = value;
                     derived().set(std::forward<U>(value));
                     return right;
                 }
 
+                // in-place mutation (default: mutate a copy and assign it back)
+                template <typename Func>
+                requires has_getter && has_setter && std::invocable<Func&, std::remove_cvref_t<ReturnType>&>
+                constexpr void modify(Func&& func) const
+                {
+                    auto value = std::remove_cvref_t<ReturnType>(derived().get());
+                    func(value);
+                    derived().set(std::move(value));
+                }
+                template <typename Func>
+                requires has_getter && has_setter && std::invocable<Func&, std::remove_cvref_t<ReturnType>&>
+                constexpr void modify(Func&& func)
+                {
+                    auto value = std::remove_cvref_t<ReturnType>(derived().get());
+                    func(value);
+                    derived().set(std::move(value));
+                }
+
 #pragma region lvalue operators
                 template <typename S>
                 requires has_getter && requires(ReturnType v, S&& i) { v[std::forward<S>(i)]; }
-                decltype(auto) operator[](S&& i) const&
+                constexpr decltype(auto) operator[](S&& i) const&
                 {
                     return derived()()[std::forward<S>(i)];
                 }
-                auto operator++(int) const&
+                constexpr auto operator++(int) const&
                 requires has_getter && has_setter && requires(ReturnType v) { v + 1; }
                 {
                     const auto prev = derived()();
                     operator=(prev + 1);
                     return prev;
                 }
-                auto operator--(int) const&
+                constexpr auto operator--(int) const&
                 requires has_getter && has_setter && requires(ReturnType v) { v - 1; }
                 {
                     const auto prev = derived()();
                     operator=(prev - 1);
                     return prev;
                 }
-                decltype(auto) operator++() const&
+                constexpr decltype(auto) operator++() const&
                 requires has_getter && has_setter && requires(ReturnType v) { v + 1; }
                 {
                     return operator=(derived()() + 1);
                 }
-                decltype(auto) operator--() const&
+                constexpr decltype(auto) operator--() const&
                 requires has_getter && has_setter && requires(ReturnType v) { v - 1; }
                 {
                     return operator=(derived()() - 1);
                 }
-                decltype(auto) operator~() const&
+                constexpr decltype(auto) operator~() const&
                 requires has_getter && requires(ReturnType v) { ~v; }
                 {
                     return ~derived()();
                 }
-                decltype(auto) operator!() const&
+                constexpr decltype(auto) operator!() const&
                 requires has_getter && requires(ReturnType v) { !v; }
                 {
                     return !derived()();
                 }
-                decltype(auto) operator-() const&
+                constexpr decltype(auto) operator-() const&
                 requires has_getter && requires(ReturnType v) { -v; }
                 {
                     return -derived()();
                 }
-                decltype(auto) operator+() const&
+                constexpr decltype(auto) operator+() const&
                 requires has_getter && requires(ReturnType v) { +v; }
                 {
                     return +derived()();
@@ -262,282 +427,390 @@ namespace cpp_property
 
                 template <typename U>
                 requires has_getter && has_setter && requires(ReturnType v, const U& r) { v * r; }
-                decltype(auto) operator*=(const U& right) const&
+                constexpr decltype(auto) operator*=(const U& right) const&
                 {
                     return operator=(derived()() * right);
                 }
                 template <typename U>
                 requires has_getter && has_setter && requires(ReturnType v, const U& r) { v / r; }
-                decltype(auto) operator/=(const U& right) const&
+                constexpr decltype(auto) operator/=(const U& right) const&
                 {
                     return operator=(derived()() / right);
                 }
                 template <typename U>
                 requires has_getter && has_setter && requires(ReturnType v, const U& r) { v % r; }
-                decltype(auto) operator%=(const U& right) const&
+                constexpr decltype(auto) operator%=(const U& right) const&
                 {
                     return operator=(derived()() % right);
                 }
                 template <typename U>
                 requires has_getter && has_setter && requires(ReturnType v, const U& r) { v + r; }
-                decltype(auto) operator+=(const U& right) const&
+                constexpr decltype(auto) operator+=(const U& right) const&
                 {
                     return operator=(derived()() + right);
                 }
                 template <typename U>
                 requires has_getter && has_setter && requires(ReturnType v, const U& r) { v - r; }
-                decltype(auto) operator-=(const U& right) const&
+                constexpr decltype(auto) operator-=(const U& right) const&
                 {
                     return operator=(derived()() - right);
                 }
                 template <typename U>
                 requires has_getter && has_setter && requires(ReturnType v, const U& r) { v << r; }
-                decltype(auto) operator<<=(const U& right) const&
+                constexpr decltype(auto) operator<<=(const U& right) const&
                 {
                     return operator=(derived()() << right);
                 }
                 template <typename U>
                 requires has_getter && has_setter && requires(ReturnType v, const U& r) { v >> r; }
-                decltype(auto) operator>>=(const U& right) const&
+                constexpr decltype(auto) operator>>=(const U& right) const&
                 {
                     return operator=(derived()() >> right);
                 }
                 template <typename U>
                 requires has_getter && has_setter && requires(ReturnType v, const U& r) { v & r; }
-                decltype(auto) operator&=(const U& right) const&
+                constexpr decltype(auto) operator&=(const U& right) const&
                 {
                     return operator=(derived()() & right);
                 }
                 template <typename U>
                 requires has_getter && has_setter && requires(ReturnType v, const U& r) { v | r; }
-                decltype(auto) operator|=(const U& right) const&
+                constexpr decltype(auto) operator|=(const U& right) const&
                 {
                     return operator=(derived()() | right);
                 }
                 template <typename U>
                 requires has_getter && has_setter && requires(ReturnType v, const U& r) { v ^ r; }
-                decltype(auto) operator^=(const U& right) const&
+                constexpr decltype(auto) operator^=(const U& right) const&
                 {
                     return operator=(derived()() ^ right);
                 }
 #pragma endregion
             };
 
+            // opt-in base of properties whose setter is non-const (the const-qualified operators of property_base
+            // cannot call it): increment, decrement and compound assignment of non-const lvalues, as hidden friends
+            // which assign through the public operator= of the property
+            template <typename DerivedType>
+            class mutable_operators
+            {
+            protected:
+                mutable_operators() = default;
+
+            public:
+                friend constexpr auto operator++(DerivedType& prop, int)
+                requires requires { prop = prop() + 1; }
+                {
+                    const auto prev = prop();
+                    prop = prev + 1;
+                    return prev;
+                }
+                friend constexpr auto operator--(DerivedType& prop, int)
+                requires requires { prop = prop() - 1; }
+                {
+                    const auto prev = prop();
+                    prop = prev - 1;
+                    return prev;
+                }
+                friend constexpr decltype(auto) operator++(DerivedType& prop)
+                requires requires { prop = prop() + 1; }
+                {
+                    return prop = prop() + 1;
+                }
+                friend constexpr decltype(auto) operator--(DerivedType& prop)
+                requires requires { prop = prop() - 1; }
+                {
+                    return prop = prop() - 1;
+                }
+                template <typename U>
+                requires requires(DerivedType& p, const U& r) { p = p() * r; }
+                friend constexpr decltype(auto) operator*=(DerivedType& prop, const U& right)
+                {
+                    return prop = prop() * right;
+                }
+                template <typename U>
+                requires requires(DerivedType& p, const U& r) { p = p() / r; }
+                friend constexpr decltype(auto) operator/=(DerivedType& prop, const U& right)
+                {
+                    return prop = prop() / right;
+                }
+                template <typename U>
+                requires requires(DerivedType& p, const U& r) { p = p() % r; }
+                friend constexpr decltype(auto) operator%=(DerivedType& prop, const U& right)
+                {
+                    return prop = prop() % right;
+                }
+                template <typename U>
+                requires requires(DerivedType& p, const U& r) { p = p() + r; }
+                friend constexpr decltype(auto) operator+=(DerivedType& prop, const U& right)
+                {
+                    return prop = prop() + right;
+                }
+                template <typename U>
+                requires requires(DerivedType& p, const U& r) { p = p() - r; }
+                friend constexpr decltype(auto) operator-=(DerivedType& prop, const U& right)
+                {
+                    return prop = prop() - right;
+                }
+                template <typename U>
+                requires requires(DerivedType& p, const U& r) { p = p() << r; }
+                friend constexpr decltype(auto) operator<<=(DerivedType& prop, const U& right)
+                {
+                    return prop = prop() << right;
+                }
+                template <typename U>
+                requires requires(DerivedType& p, const U& r) { p = p() >> r; }
+                friend constexpr decltype(auto) operator>>=(DerivedType& prop, const U& right)
+                {
+                    return prop = prop() >> right;
+                }
+                template <typename U>
+                requires requires(DerivedType& p, const U& r) { p = p() & r; }
+                friend constexpr decltype(auto) operator&=(DerivedType& prop, const U& right)
+                {
+                    return prop = prop() & right;
+                }
+                template <typename U>
+                requires requires(DerivedType& p, const U& r) { p = p() | r; }
+                friend constexpr decltype(auto) operator|=(DerivedType& prop, const U& right)
+                {
+                    return prop = prop() | right;
+                }
+                template <typename U>
+                requires requires(DerivedType& p, const U& r) { p = p() ^ r; }
+                friend constexpr decltype(auto) operator^=(DerivedType& prop, const U& right)
+                {
+                    return prop = prop() ^ right;
+                }
+            };
+
 #pragma region global operators(property / not property)
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() * std::forward<U>(r); }
-            decltype(auto) operator*(const V& t1, U&& t2)
+            constexpr decltype(auto) operator*(const V& t1, U&& t2)
             {
                 return t1() * std::forward<U>(t2);
             }
 
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() / std::forward<U>(r); }
-            decltype(auto) operator/(const V& t1, U&& t2)
+            constexpr decltype(auto) operator/(const V& t1, U&& t2)
             {
                 return t1() / std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() % std::forward<U>(r); }
-            decltype(auto) operator%(const V& t1, U&& t2)
+            constexpr decltype(auto) operator%(const V& t1, U&& t2)
             {
                 return t1() % std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() + std::forward<U>(r); }
-            decltype(auto) operator+(const V& t1, U&& t2)
+            constexpr decltype(auto) operator+(const V& t1, U&& t2)
             {
                 return t1() + std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() - std::forward<U>(r); }
-            decltype(auto) operator-(const V& t1, U&& t2)
+            constexpr decltype(auto) operator-(const V& t1, U&& t2)
             {
                 return t1() - std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() << std::forward<U>(r); }
-            decltype(auto) operator<<(const V& t1, U&& t2)
+            constexpr decltype(auto) operator<<(const V& t1, U&& t2)
             {
                 return t1() << std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() >> std::forward<U>(r); }
-            decltype(auto) operator>>(const V& t1, U&& t2)
+            constexpr decltype(auto) operator>>(const V& t1, U&& t2)
             {
                 return t1() >> std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() < std::forward<U>(r); }
-            decltype(auto) operator<(const V& t1, U&& t2)
+            constexpr decltype(auto) operator<(const V& t1, U&& t2)
             {
                 return t1() < std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() > std::forward<U>(r); }
-            decltype(auto) operator>(const V& t1, U&& t2)
+            constexpr decltype(auto) operator>(const V& t1, U&& t2)
             {
                 return t1() > std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() <= std::forward<U>(r); }
-            decltype(auto) operator<=(const V& t1, U&& t2)
+            constexpr decltype(auto) operator<=(const V& t1, U&& t2)
             {
                 return t1() <= std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() >= std::forward<U>(r); }
-            decltype(auto) operator>=(const V& t1, U&& t2)
+            constexpr decltype(auto) operator>=(const V& t1, U&& t2)
             {
                 return t1() >= std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() == std::forward<U>(r); }
-            decltype(auto) operator==(const V& t1, U&& t2)
+            constexpr decltype(auto) operator==(const V& t1, U&& t2)
             {
                 return t1() == std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() != std::forward<U>(r); }
-            decltype(auto) operator!=(const V& t1, U&& t2)
+            constexpr decltype(auto) operator!=(const V& t1, U&& t2)
             {
                 return t1() != std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
+            requires requires(const V& v, U&& r) { v() <=> std::forward<U>(r); }
+            constexpr decltype(auto) operator<=>(const V& t1, U&& t2)
+            {
+                return t1() <=> std::forward<U>(t2);
+            }
+            template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() & std::forward<U>(r); }
-            decltype(auto) operator&(const V& t1, U&& t2)
+            constexpr decltype(auto) operator&(const V& t1, U&& t2)
             {
                 return t1() & std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() ^ std::forward<U>(r); }
-            decltype(auto) operator^(const V& t1, U&& t2)
+            constexpr decltype(auto) operator^(const V& t1, U&& t2)
             {
                 return t1() ^ std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() | std::forward<U>(r); }
-            decltype(auto) operator|(const V& t1, U&& t2)
+            constexpr decltype(auto) operator|(const V& t1, U&& t2)
             {
                 return t1() | std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() && std::forward<U>(r); }
-            decltype(auto) operator&&(const V& t1, U&& t2)
+            constexpr decltype(auto) operator&&(const V& t1, U&& t2)
             {
                 return t1() && std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(const V& v, U&& r) { v() || std::forward<U>(r); }
-            decltype(auto) operator||(const V& t1, U&& t2)
+            constexpr decltype(auto) operator||(const V& t1, U&& t2)
             {
                 return t1() || std::forward<U>(t2);
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) * v(); }
-            decltype(auto) operator*(U&& t1, const V& t2)
+            constexpr decltype(auto) operator*(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) * t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) / v(); }
-            decltype(auto) operator/(U&& t1, const V& t2)
+            constexpr decltype(auto) operator/(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) / t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) % v(); }
-            decltype(auto) operator%(U&& t1, const V& t2)
+            constexpr decltype(auto) operator%(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) % t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) + v(); }
-            decltype(auto) operator+(U&& t1, const V& t2)
+            constexpr decltype(auto) operator+(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) + t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) - v(); }
-            decltype(auto) operator-(U&& t1, const V& t2)
+            constexpr decltype(auto) operator-(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) - t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) << v(); }
-            decltype(auto) operator<<(U&& t1, const V& t2)
+            constexpr decltype(auto) operator<<(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) << t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) >> v(); }
-            decltype(auto) operator>>(U&& t1, const V& t2)
+            constexpr decltype(auto) operator>>(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) >> t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) < v(); }
-            decltype(auto) operator<(U&& t1, const V& t2)
+            constexpr decltype(auto) operator<(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) < t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) > v(); }
-            decltype(auto) operator>(U&& t1, const V& t2)
+            constexpr decltype(auto) operator>(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) > t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) <= v(); }
-            decltype(auto) operator<=(U&& t1, const V& t2)
+            constexpr decltype(auto) operator<=(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) <= t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) >= v(); }
-            decltype(auto) operator>=(U&& t1, const V& t2)
+            constexpr decltype(auto) operator>=(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) >= t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) == v(); }
-            decltype(auto) operator==(U&& t1, const V& t2)
+            constexpr decltype(auto) operator==(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) == t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) != v(); }
-            decltype(auto) operator!=(U&& t1, const V& t2)
+            constexpr decltype(auto) operator!=(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) != t2();
             }
             template <not_base_of_property U, base_of_property V>
+            requires requires(U&& r, const V& v) { std::forward<U>(r) <=> v(); }
+            constexpr decltype(auto) operator<=>(U&& t1, const V& t2)
+            {
+                return std::forward<U>(t1) <=> t2();
+            }
+            template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) & v(); }
-            decltype(auto) operator&(U&& t1, const V& t2)
+            constexpr decltype(auto) operator&(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) & t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) ^ v(); }
-            decltype(auto) operator^(U&& t1, const V& t2)
+            constexpr decltype(auto) operator^(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) ^ t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) | v(); }
-            decltype(auto) operator|(U&& t1, const V& t2)
+            constexpr decltype(auto) operator|(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) | t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) && v(); }
-            decltype(auto) operator&&(U&& t1, const V& t2)
+            constexpr decltype(auto) operator&&(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) && t2();
             }
             template <not_base_of_property U, base_of_property V>
             requires requires(U&& r, const V& v) { std::forward<U>(r) || v(); }
-            decltype(auto) operator||(U&& t1, const V& t2)
+            constexpr decltype(auto) operator||(U&& t1, const V& t2)
             {
                 return std::forward<U>(t1) || t2();
             }
@@ -546,114 +819,124 @@ namespace cpp_property
 #pragma region global operators(property / property)
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() * v(); }
-            decltype(auto) operator*(const U& t1, const V& t2)
+            constexpr decltype(auto) operator*(const U& t1, const V& t2)
             {
                 return t1() * t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() / v(); }
-            decltype(auto) operator/(const U& t1, const V& t2)
+            constexpr decltype(auto) operator/(const U& t1, const V& t2)
             {
                 return t1() / t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() % v(); }
-            decltype(auto) operator%(const U& t1, const V& t2)
+            constexpr decltype(auto) operator%(const U& t1, const V& t2)
             {
                 return t1() % t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() + v(); }
-            decltype(auto) operator+(const U& t1, const V& t2)
+            constexpr decltype(auto) operator+(const U& t1, const V& t2)
             {
                 return t1() + t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() - v(); }
-            decltype(auto) operator-(const U& t1, const V& t2)
+            constexpr decltype(auto) operator-(const U& t1, const V& t2)
             {
                 return t1() - t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() << v(); }
-            decltype(auto) operator<<(const U& t1, const V& t2)
+            constexpr decltype(auto) operator<<(const U& t1, const V& t2)
             {
                 return t1() << t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() >> v(); }
-            decltype(auto) operator>>(const U& t1, const V& t2)
+            constexpr decltype(auto) operator>>(const U& t1, const V& t2)
             {
                 return t1() >> t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() < v(); }
-            decltype(auto) operator<(const U& t1, const V& t2)
+            constexpr decltype(auto) operator<(const U& t1, const V& t2)
             {
                 return t1() < t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() > v(); }
-            decltype(auto) operator>(const U& t1, const V& t2)
+            constexpr decltype(auto) operator>(const U& t1, const V& t2)
             {
                 return t1() > t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() <= v(); }
-            decltype(auto) operator<=(const U& t1, const V& t2)
+            constexpr decltype(auto) operator<=(const U& t1, const V& t2)
             {
                 return t1() <= t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() >= v(); }
-            decltype(auto) operator>=(const U& t1, const V& t2)
+            constexpr decltype(auto) operator>=(const U& t1, const V& t2)
             {
                 return t1() >= t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() == v(); }
-            decltype(auto) operator==(const U& t1, const V& t2)
+            constexpr decltype(auto) operator==(const U& t1, const V& t2)
             {
                 return t1() == t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() != v(); }
-            decltype(auto) operator!=(const U& t1, const V& t2)
+            constexpr decltype(auto) operator!=(const U& t1, const V& t2)
             {
                 return t1() != t2();
             }
             template <base_of_property U, base_of_property V>
+            requires requires(const U& u, const V& v) { u() <=> v(); }
+            constexpr decltype(auto) operator<=>(const U& t1, const V& t2)
+            {
+                return t1() <=> t2();
+            }
+            template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() & v(); }
-            decltype(auto) operator&(const U& t1, const V& t2)
+            constexpr decltype(auto) operator&(const U& t1, const V& t2)
             {
                 return t1() & t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() ^ v(); }
-            decltype(auto) operator^(const U& t1, const V& t2)
+            constexpr decltype(auto) operator^(const U& t1, const V& t2)
             {
                 return t1() ^ t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() | v(); }
-            decltype(auto) operator|(const U& t1, const V& t2)
+            constexpr decltype(auto) operator|(const U& t1, const V& t2)
             {
                 return t1() | t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() && v(); }
-            decltype(auto) operator&&(const U& t1, const V& t2)
+            constexpr decltype(auto) operator&&(const U& t1, const V& t2)
             {
                 return t1() && t2();
             }
             template <base_of_property U, base_of_property V>
             requires requires(const U& u, const V& v) { u() || v(); }
-            decltype(auto) operator||(const U& t1, const V& t2)
+            constexpr decltype(auto) operator||(const U& t1, const V& t2)
             {
                 return t1() || t2();
             }
 #pragma endregion operators(property / property)
         }  // namespace detail
+
+        // unambiguous name of the private namespace for public types of extension headers, which are declared
+        // after detail is closed below
+        namespace impl = detail;
     }  // namespace
 
     struct get_only
@@ -662,6 +945,9 @@ namespace cpp_property
     struct set_only
     {
     };
+    struct modifiable
+    {
+    };
 
     template <typename T>
     class get_auto
@@ -670,8 +956,8 @@ namespace cpp_property
 
     public:
         get_auto() = default;
-        explicit get_auto(const T& t) : entity_(&t) {}
-        const T& get() const { return *entity_; }
+        constexpr explicit get_auto(const T& t) : entity_(&t) {}
+        constexpr const T& get() const { return *entity_; }
     };
     template <>
     class get_auto<void>
@@ -688,10 +974,10 @@ namespace cpp_property
 
     public:
         set_auto() = default;
-        explicit set_auto(T& t) : entity_(&t) {}
+        constexpr explicit set_auto(T& t) : entity_(&t) {}
         template <typename V>
         requires requires(T* t, V&& v) { *t = std::forward<V>(v); }
-        void set(V&& value) const
+        constexpr void set(V&& value) const
         {
             *entity_ = std::forward<V>(value);
         }
@@ -724,9 +1010,9 @@ namespace cpp_property
         using EntityType = std::remove_cvref_t<ReturnType>;
         using ArgumentType = std::remove_cvref_t<ReturnType>;
         const detail::small_function<ReturnType()> getter_;        // NOLINT
-        mutable get_auto<EntityType> auto_getter_;
+        get_auto<EntityType> auto_getter_;
         const detail::small_function<void(ArgumentType)> setter_;  // NOLINT
-        mutable set_auto<EntityType> auto_setter_;
+        set_auto<EntityType> auto_setter_;
 
     public:
         property() = delete;
@@ -737,12 +1023,12 @@ namespace cpp_property
             detail::small_function<void(ArgumentType)>{s};
             requires !(detail::is_dangling_reference<ReturnType, decltype(g())>);
         }
-        property(Getter&& get_f, Setter&& set_f)
+        constexpr property(Getter&& get_f, Setter&& set_f)
             : getter_(std::forward<Getter>(get_f)), setter_(std::forward<Setter>(set_f))
         {
         }
 
-        property(get_auto<EntityType> get_f, set_auto<EntityType> set_f)
+        constexpr property(get_auto<EntityType> get_f, set_auto<EntityType> set_f)
         requires is_const_lvalue_reference_v<ReturnType>
             : auto_getter_(std::move(get_f)), auto_setter_(std::move(set_f))
         {
@@ -751,7 +1037,7 @@ namespace cpp_property
         template <typename Setter>
         requires is_const_lvalue_reference_v<ReturnType> &&
                      requires(Setter&& s) { detail::small_function<void(ArgumentType)>{s}; }
-        property(get_auto<EntityType> get_f, Setter&& set_f)
+        constexpr property(get_auto<EntityType> get_f, Setter&& set_f)
             : auto_getter_(std::move(get_f)), setter_(std::forward<Setter>(set_f))
         {
         }
@@ -761,32 +1047,32 @@ namespace cpp_property
             detail::small_function<ReturnType()>{g};
             requires !(detail::is_dangling_reference<ReturnType, decltype(g())>);
         }
-        property(Getter&& get_f, set_auto<EntityType> set_f)
+        constexpr property(Getter&& get_f, set_auto<EntityType> set_f)
             : getter_(std::forward<Getter>(get_f)), auto_setter_(std::move(set_f))
         {
         }
 
         // copy assign operator (but not copy)
-        decltype(auto) operator=(const property& right) const { return Base::operator=(right()); }
+        constexpr decltype(auto) operator=(const property& right) const { return Base::operator=(right()); }
 
         // assign operator
         template <detail::base_of_property PropertyType>
         requires requires(const decltype(setter_)& s, const PropertyType p) { s(p()); } &&
                  requires(const decltype(auto_setter_)& s, const PropertyType p) { s.set(p()); }
-        decltype(auto) operator=(const PropertyType& prop) const
+        constexpr decltype(auto) operator=(const PropertyType& prop) const
         {
             return Base::operator=(prop());
         };
         template <detail::not_base_of_property U>
         requires requires(const decltype(setter_)& s, U&& v) { s(std::forward<U>(v)); } &&
                  requires(const decltype(auto_setter_)& s, U&& v) { s.set(std::forward<U>(v)); }
-        decltype(auto) operator=(U&& value) const
+        constexpr decltype(auto) operator=(U&& value) const
         {
             return Base::operator=(std::forward<U>(value));
         };
 
     private:
-        [[nodiscard]] ReturnType get() const
+        [[nodiscard]] constexpr ReturnType get() const
         {
             if constexpr (is_const_lvalue_reference_v<ReturnType>)
             {
@@ -799,7 +1085,7 @@ namespace cpp_property
             }
         }
         template <detail::not_base_of_property U>
-        void set(U&& value) const
+        constexpr void set(U&& value) const
         {
             if (setter_)
                 setter_(std::forward<U>(value));
@@ -820,9 +1106,9 @@ namespace cpp_property
 
         using EntityType = std::remove_cvref_t<ReturnType>;
         const detail::small_function<ReturnType()> getter_;        // NOLINT
-        mutable get_auto<EntityType> auto_getter_;
+        get_auto<EntityType> auto_getter_;
         const detail::small_function<void(ArgumentType)> setter_;  // NOLINT
-        mutable set_auto<EntityType> auto_setter_;
+        set_auto<EntityType> auto_setter_;
 
     public:
         property() = delete;
@@ -833,12 +1119,12 @@ namespace cpp_property
             detail::small_function<void(ArgumentType)>{s};
             requires !(detail::is_dangling_reference<ReturnType, decltype(g())>);
         }
-        property(Getter&& get_f, Setter&& set_f)
+        constexpr property(Getter&& get_f, Setter&& set_f)
             : getter_(std::forward<Getter>(get_f)), setter_(std::forward<Setter>(set_f))
         {
         }
 
-        property(get_auto<EntityType> get_f, set_auto<EntityType> set_f)
+        constexpr property(get_auto<EntityType> get_f, set_auto<EntityType> set_f)
         requires is_const_lvalue_reference_v<ReturnType>
             : auto_getter_(std::move(get_f)), auto_setter_(std::move(set_f))
         {
@@ -847,7 +1133,7 @@ namespace cpp_property
         template <typename Setter>
         requires is_const_lvalue_reference_v<ReturnType> &&
                      requires(Setter&& s) { detail::small_function<void(ArgumentType)>{s}; }
-        property(get_auto<EntityType> get_f, Setter&& set_f)
+        constexpr property(get_auto<EntityType> get_f, Setter&& set_f)
             : auto_getter_(std::move(get_f)), setter_(std::forward<Setter>(set_f))
         {
         }
@@ -857,32 +1143,32 @@ namespace cpp_property
             detail::small_function<ReturnType()>{g};
             requires !(detail::is_dangling_reference<ReturnType, decltype(g())>);
         }
-        property(Getter&& get_f, set_auto<EntityType> set_f)
+        constexpr property(Getter&& get_f, set_auto<EntityType> set_f)
             : getter_(std::forward<Getter>(get_f)), auto_setter_(std::move(set_f))
         {
         }
 
         // copy assign operator (but not copy)
-        decltype(auto) operator=(const property& right) const { return Base::operator=(right()); }
+        constexpr decltype(auto) operator=(const property& right) const { return Base::operator=(right()); }
 
         // assign operator
         template <detail::base_of_property PropertyType>
         requires requires(const decltype(setter_)& s, const PropertyType p) { s(p()); } &&
                  requires(const decltype(auto_setter_)& s, const PropertyType p) { s.set(p()); }
-        decltype(auto) operator=(const PropertyType& prop) const
+        constexpr decltype(auto) operator=(const PropertyType& prop) const
         {
             return Base::operator=(prop());
         };
         template <detail::not_base_of_property U>
         requires requires(const decltype(setter_)& s, U&& v) { s(std::forward<U>(v)); } &&
                  requires(const decltype(auto_setter_)& s, U&& v) { s.set(std::forward<U>(v)); }
-        decltype(auto) operator=(U&& value) const
+        constexpr decltype(auto) operator=(U&& value) const
         {
             return Base::operator=(std::forward<U>(value));
         };
 
     private:
-        [[nodiscard]] ReturnType get() const
+        [[nodiscard]] constexpr ReturnType get() const
         {
             if constexpr (is_const_lvalue_reference_v<ReturnType>)
             {
@@ -895,7 +1181,7 @@ namespace cpp_property
             }
         }
         template <detail::not_base_of_property U>
-        void set(U&& value) const
+        constexpr void set(U&& value) const
         {
             if (setter_)
                 setter_(std::forward<U>(value));
@@ -916,7 +1202,7 @@ namespace cpp_property
 
         using EntityType = std::remove_cvref_t<ReturnType>;
         const detail::small_function<ReturnType()> getter_;  // NOLINT
-        mutable get_auto<EntityType> auto_getter_;
+        get_auto<EntityType> auto_getter_;
 
     public:
         property() = delete;
@@ -926,18 +1212,18 @@ namespace cpp_property
             detail::small_function<ReturnType()>{g};
             requires !(detail::is_dangling_reference<ReturnType, decltype(g())>);
         }
-        property(Getter&& get_f) : getter_(std::forward<Getter>(get_f))  // NOLINT
+        constexpr property(Getter&& get_f) : getter_(std::forward<Getter>(get_f))  // NOLINT
         {
         }
 
-        property(get_auto<EntityType> get_f)  // NOLINT
+        constexpr property(get_auto<EntityType> get_f)  // NOLINT
         requires is_const_lvalue_reference_v<ReturnType>
             : auto_getter_(std::move(get_f))
         {
         }
 
     private:
-        [[nodiscard]] ReturnType get() const
+        [[nodiscard]] constexpr ReturnType get() const
         {
             if constexpr (is_const_lvalue_reference_v<ReturnType>)
             {
@@ -963,18 +1249,18 @@ namespace cpp_property
 
         using EntityType = std::remove_cvref_t<ArgumentType>;
         const detail::small_function<void(ArgumentType)> setter_;  // NOLINT
-        mutable set_auto<EntityType> auto_setter_;
+        set_auto<EntityType> auto_setter_;
 
     public:
         property() = delete;
 
         template <typename Setter>
         requires requires(Setter&& s) { detail::small_function<void(ArgumentType)>{s}; }
-        property(Setter&& set_f) : setter_(std::forward<Setter>(set_f))  // NOLINT
+        constexpr property(Setter&& set_f) : setter_(std::forward<Setter>(set_f))  // NOLINT
         {
         }
 
-        property(set_auto<EntityType> set_f) : auto_setter_(std::move(set_f)) {}  // NOLINT
+        constexpr property(set_auto<EntityType> set_f) : auto_setter_(std::move(set_f)) {}  // NOLINT
 
         // copy assign operator (deleted)
         property& operator=(const property&) = delete;
@@ -983,21 +1269,21 @@ namespace cpp_property
         template <detail::base_of_property PropertyType>
         requires requires(const decltype(setter_)& s, const PropertyType p) { s(p()); } &&
                  requires(const decltype(auto_setter_)& s, const PropertyType p) { s.set(p()); }
-        decltype(auto) operator=(const PropertyType& prop) const
+        constexpr decltype(auto) operator=(const PropertyType& prop) const
         {
             return Base::operator=(prop());
         };
         template <detail::not_base_of_property U>
         requires requires(const decltype(setter_)& s, U&& v) { s(std::forward<U>(v)); } &&
                  requires(const decltype(auto_setter_)& s, U&& v) { s.set(std::forward<U>(v)); }
-        decltype(auto) operator=(U&& value) const
+        constexpr decltype(auto) operator=(U&& value) const
         {
             return Base::operator=(std::forward<U>(value));
         };
 
     private:
         template <detail::not_base_of_property U>
-        void set(U&& value) const
+        constexpr void set(U&& value) const
         {
             if (setter_)
                 setter_(std::forward<U>(value));
@@ -1006,8 +1292,79 @@ namespace cpp_property
         }
     };
 
+    // property with a third accessor which runs a mutation in place followed by validation or notification
+    template <typename ReturnType, typename ArgumentType>
+    class property<ReturnType, ArgumentType, modifiable>
+        : public detail::property_base<property<ReturnType, ArgumentType, modifiable>, ReturnType, ArgumentType>
+    {
+        using Base = detail::property_base<property<ReturnType, ArgumentType, modifiable>, ReturnType, ArgumentType>;
+        friend Base;
+
+        template <typename...>
+        friend class property;
+
+        using EntityType = std::remove_cvref_t<ReturnType>;
+        const detail::small_function<ReturnType()> getter_;                          // NOLINT
+        const detail::small_function<void(ArgumentType)> setter_;                    // NOLINT
+        const detail::small_function<void(detail::mutator<EntityType>)> modifier_;  // NOLINT
+
+    public:
+        property() = delete;
+
+        template <typename Getter, typename Setter, typename Modifier>
+        requires requires(Getter&& g, Setter&& s, Modifier&& m) {
+            detail::small_function<ReturnType()>{g};
+            detail::small_function<void(ArgumentType)>{s};
+            detail::small_function<void(detail::mutator<EntityType>)>{m};
+            requires !(detail::is_dangling_reference<ReturnType, decltype(g())>);
+        }
+        property(Getter&& get_f, Setter&& set_f, Modifier&& modify_f)
+            : getter_(std::forward<Getter>(get_f)), setter_(std::forward<Setter>(set_f)),
+              modifier_(std::forward<Modifier>(modify_f))
+        {
+        }
+
+        // copy assign operator (but not copy)
+        decltype(auto) operator=(const property& right) const { return Base::operator=(right()); }
+
+        // assign operator
+        template <detail::base_of_property PropertyType>
+        requires requires(const decltype(setter_)& s, const PropertyType p) { s(p()); }
+        decltype(auto) operator=(const PropertyType& prop) const
+        {
+            return Base::operator=(prop());
+        };
+        template <detail::not_base_of_property U>
+        requires requires(const decltype(setter_)& s, U&& v) { s(std::forward<U>(v)); }
+        decltype(auto) operator=(U&& value) const
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+        // pass the mutation to the modifier accessor, which applies it to the backing field without copying
+        // (there is no rollback: if the modifier throws after the mutation, e.g. from a validation, the backing field
+        // keeps the mutated value unless the modifier restores it itself)
+        template <typename Func>
+        requires std::invocable<Func&, EntityType&>
+        void modify(Func&& func) const
+        {
+            modifier_(detail::mutator<EntityType>(func));
+        }
+
+    private:
+        [[nodiscard]] ReturnType get() const { return getter_(); }
+        template <detail::not_base_of_property U>
+        void set(U&& value) const
+        {
+            setter_(std::forward<U>(value));
+        }
+    };
+
     template <typename Getter, typename Setter>
     property(Getter&&, Setter&&) -> property<detail::getter_return_type<Getter>, detail::setter_argument_type<Setter>>;
+    template <typename Getter, typename Setter, typename Modifier>
+    property(Getter&&, Setter&&, Modifier&&)
+        -> property<detail::getter_return_type<Getter>, detail::setter_argument_type<Setter>, modifiable>;
     template <typename EntityType>
     property(get_auto<EntityType>&&, set_auto<EntityType>&&) -> property<const EntityType&>;
     template <typename Getter, typename EntityType>
@@ -1023,6 +1380,164 @@ namespace cpp_property
     template <typename EntityType>
     property(set_auto<EntityType>&&) -> property<EntityType, set_only>;
 
+    template <typename...>
+    class indexed_property;
+
+    template <typename ReturnType, typename KeyType, typename... Options>
+    requires (sizeof...(Options) == 0) || (std::same_as<get_only, Options> && ...)
+    class indexed_property<ReturnType(KeyType), Options...>
+    {
+        static constexpr auto has_setter = sizeof...(Options) == 0;
+        using EntityType = std::remove_cvref_t<ReturnType>;
+        using ArgumentType = std::conditional_t<has_setter, EntityType, void>;
+        using Setter = std::conditional_t<has_setter, detail::small_function<void(KeyType, EntityType)>, get_only>;
+
+        const detail::small_function<ReturnType(KeyType)> getter_;  // NOLINT
+        [[no_unique_address]] const Setter setter_{};              // NOLINT
+
+    public:
+        // accessor of one element with the operators of properties
+        class element : public detail::property_base<element, ReturnType, ArgumentType>
+        {
+            using Base = detail::property_base<element, ReturnType, ArgumentType>;
+            friend Base;
+            friend class indexed_property;
+
+            const indexed_property& owner_;
+            KeyType key_;
+
+            element(const indexed_property& owner, KeyType key) : owner_(owner), key_(std::move(key)) {}
+
+        public:
+            // copy assign operator (but not copy)
+            decltype(auto) operator=(const element& right) const
+            requires has_setter
+            {
+                return Base::operator=(right());
+            }
+
+            // assign operator
+            template <detail::base_of_property PropertyType>
+            requires has_setter && requires(EntityType& e, const PropertyType p) { e = p(); }
+            decltype(auto) operator=(const PropertyType& prop) const
+            {
+                return Base::operator=(prop());
+            };
+            template <detail::not_base_of_property U>
+            requires has_setter && std::convertible_to<U&&, EntityType>
+            decltype(auto) operator=(U&& value) const
+            {
+                return Base::operator=(std::forward<U>(value));
+            };
+
+        private:
+            [[nodiscard]] ReturnType get() const { return owner_.getter_(key_); }
+            template <detail::not_base_of_property U>
+            void set(U&& value) const
+            {
+                owner_.setter_(key_, std::forward<U>(value));
+            }
+        };
+
+        // lazy view of the elements in [first, last)
+        class range_view
+        {
+            const indexed_property* owner_;
+            KeyType first_;
+            KeyType last_;
+
+        public:
+            class iterator
+            {
+                const indexed_property* owner_ = nullptr;
+                KeyType key_ = {};
+
+            public:
+                using value_type = EntityType;
+                using difference_type = std::ptrdiff_t;
+
+                iterator() = default;
+                iterator(const indexed_property* owner, KeyType key) : owner_(owner), key_(key) {}
+                ReturnType operator*() const { return owner_->getter_(key_); }
+                iterator& operator++()
+                {
+                    ++key_;
+                    return *this;
+                }
+                iterator operator++(int)
+                {
+                    auto prev = *this;
+                    ++key_;
+                    return prev;
+                }
+                bool operator==(const iterator& right) const { return key_ == right.key_; }
+            };
+
+            range_view(const indexed_property* owner, KeyType first, KeyType last)
+                : owner_(owner), first_(first), last_(last)
+            {
+            }
+            [[nodiscard]] iterator begin() const { return {owner_, first_}; }
+            [[nodiscard]] iterator end() const { return {owner_, last_}; }
+            [[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(last_ - first_); }
+            [[nodiscard]] bool empty() const { return first_ == last_; }
+        };
+
+        indexed_property() = delete;
+        indexed_property(const indexed_property&) = delete;
+        indexed_property(indexed_property&&) = delete;
+        indexed_property& operator=(const indexed_property&) = delete;
+        indexed_property& operator=(indexed_property&&) = delete;
+        ~indexed_property() = default;
+
+        template <typename Getter, typename Setter>
+        requires has_setter && requires(Getter&& g, Setter&& s) {
+            detail::small_function<ReturnType(KeyType)>{g};
+            detail::small_function<void(KeyType, EntityType)>{s};
+            requires !(detail::is_dangling_reference<ReturnType, decltype(g(std::declval<KeyType>()))>);
+        }
+        indexed_property(Getter&& get_f, Setter&& set_f)
+            : getter_(std::forward<Getter>(get_f)), setter_(std::forward<Setter>(set_f))
+        {
+        }
+        template <typename Getter>
+        requires (!has_setter) && requires(Getter&& g) {
+            detail::small_function<ReturnType(KeyType)>{g};
+            requires !(detail::is_dangling_reference<ReturnType, decltype(g(std::declval<KeyType>()))>);
+        }
+        indexed_property(Getter&& get_f) : getter_(std::forward<Getter>(get_f))  // NOLINT
+        {
+        }
+
+        element operator[](KeyType key) const { return element(*this, std::move(key)); }
+
+        // bulk accessors for consecutive integral keys
+        template <typename OutputIterator>
+        requires std::integral<std::remove_cvref_t<KeyType>>
+        OutputIterator get_n(std::remove_cvref_t<KeyType> first, std::size_t count, OutputIterator out) const
+        {
+            for (std::size_t i = 0; i < count; ++i, ++first) *out++ = getter_(first);
+            return out;
+        }
+        template <typename InputIterator>
+        requires has_setter && std::integral<std::remove_cvref_t<KeyType>>
+        InputIterator set_n(std::remove_cvref_t<KeyType> first, std::size_t count, InputIterator in) const
+        {
+            for (std::size_t i = 0; i < count; ++i, ++first) setter_(first, *in++);
+            return in;
+        }
+        [[nodiscard]] range_view range(KeyType first, KeyType last) const
+        requires std::integral<std::remove_cvref_t<KeyType>>
+        {
+            return {this, first, last};
+        }
+    };
+
+    template <typename Getter, typename Setter>
+    indexed_property(Getter&&, Setter&&) -> indexed_property<detail::indexer_signature<Getter>>;
+    template <typename Getter>
+    indexed_property(Getter&&) -> indexed_property<detail::indexer_signature<Getter>, get_only>;
+
     template <typename...>
     class auto_property;
 
@@ -1048,26 +1563,26 @@ namespace cpp_property
         auto_property(auto_property&&) noexcept = default;
         template <typename V>
         requires (!std::is_reference_v<EntityType> || !std::is_rvalue_reference_v<V &&>)
-        explicit auto_property(V&& init) : entity_(std::forward<V>(init))
+        constexpr explicit auto_property(V&& init) : entity_(std::forward<V>(init))
         {
         }
-        auto_property(get_auto<void>, set_auto<void>)
+        constexpr auto_property(get_auto<void>, set_auto<void>)
         requires (!std::is_reference_v<EntityType>)
         {
         }
         template <typename V>
         requires (!std::is_reference_v<EntityType> || !std::is_rvalue_reference_v<V &&>)
-        auto_property(get_auto<void>, set_auto<void>, V&& init) : entity_(std::forward<V>(init))
+        constexpr auto_property(get_auto<void>, set_auto<void>, V&& init) : entity_(std::forward<V>(init))
         {
         }
 
         // copy assign operator (but not copy)
-        auto_property& operator=(const auto_property& right)
+        constexpr auto_property& operator=(const auto_property& right)
         {
             entity_ = right.entity_;
             return *this;
         }
-        auto_property& operator=(auto_property&& right) noexcept
+        constexpr auto_property& operator=(auto_property&& right) noexcept
         {
             entity_ = right.entity_;
             return *this;
@@ -1076,21 +1591,29 @@ namespace cpp_property
         // assign operator
         template <detail::base_of_property PropertyType>
         requires requires(EntityType& e, const PropertyType p) { e = p(); }
-        decltype(auto) operator=(const PropertyType& prop)
+        constexpr decltype(auto) operator=(const PropertyType& prop)
         {
             return Base::operator=(prop());
         };
         template <detail::not_base_of_property U>
         requires requires(EntityType& e, U&& v) { e = std::forward<U>(v); }
-        decltype(auto) operator=(U&& value)
+        constexpr decltype(auto) operator=(U&& value)
         {
             return Base::operator=(std::forward<U>(value));
         };
 
+        // mutate the backing field in place
+        template <typename Func>
+        requires std::invocable<Func&, std::remove_cvref_t<EntityType>&>
+        constexpr void modify(Func&& func)
+        {
+            func(entity_);
+        }
+
     private:
-        [[nodiscard]] ReturnType get() const { return entity_; }
+        [[nodiscard]] constexpr ReturnType get() const { return entity_; }
         template <detail::not_base_of_property U>
-        void set(U&& value)
+        constexpr void set(U&& value)
         {
             entity_ = std::forward<U>(value);
         }
@@ -1118,33 +1641,33 @@ namespace cpp_property
         auto_property(auto_property&&) noexcept = default;
         template <typename V>
         requires (!std::is_reference_v<EntityType> || !std::is_rvalue_reference_v<V &&>)
-        explicit auto_property(V&& init) : entity_(std::forward<V>(init))
+        constexpr explicit auto_property(V&& init) : entity_(std::forward<V>(init))
         {
         }
-        auto_property(get_auto<void>)  // NOLINT
+        constexpr auto_property(get_auto<void>)  // NOLINT
         requires (!std::is_reference_v<EntityType>)
         {
         }
         template <typename V>
         requires (!std::is_reference_v<EntityType> || !std::is_rvalue_reference_v<V &&>)
-        auto_property(get_auto<void>, V&& init) : entity_(std::forward<V>(init))
+        constexpr auto_property(get_auto<void>, V&& init) : entity_(std::forward<V>(init))
         {
         }
 
         // copy assign operator (but not copy)
-        auto_property& operator=(const auto_property& right)
+        constexpr auto_property& operator=(const auto_property& right)
         {
             entity_ = right.entity_;
             return *this;
         }
-        auto_property& operator=(auto_property&& right) noexcept
+        constexpr auto_property& operator=(auto_property&& right) noexcept
         {
             entity_ = right.entity_;
             return *this;
         }
 
     private:
-        [[nodiscard]] ReturnType get() const { return entity_; }
+        [[nodiscard]] constexpr ReturnType get() const { return entity_; }
     };
 
     template <typename EntityType>
@@ -1164,21 +1687,21 @@ namespace cpp_property
         auto_property(const auto_property&) = default;
         auto_property(auto_property&&) noexcept = default;
         template <typename V>
-        explicit auto_property(V& init) : entity_(init)
+        constexpr explicit auto_property(V& init) : entity_(init)
         {
         }
         template <typename V>
-        auto_property(set_auto<void>, V& init) : entity_(init)
+        constexpr auto_property(set_auto<void>, V& init) : entity_(init)
         {
         }
 
         // copy assign operator (but not copy)
-        auto_property& operator=(const auto_property& right)
+        constexpr auto_property& operator=(const auto_property& right)
         {
             entity_ = right.entity_;
             return *this;
         }
-        auto_property& operator=(auto_property&& right) noexcept
+        constexpr auto_property& operator=(auto_property&& right) noexcept
         {
             entity_ = right.entity_;
             return *this;
@@ -1187,20 +1710,20 @@ namespace cpp_property
         // assign operator
         template <detail::base_of_property PropertyType>
         requires requires(EntityType& e, const PropertyType p) { e = p(); }
-        decltype(auto) operator=(const PropertyType& prop)
+        constexpr decltype(auto) operator=(const PropertyType& prop)
         {
             return Base::operator=(prop());
         };
         template <detail::not_base_of_property U>
         requires requires(EntityType& e, U&& v) { e = std::forward<U>(v); }
-        decltype(auto) operator=(U&& value)
+        constexpr decltype(auto) operator=(U&& value)
         {
             return Base::operator=(std::forward<U>(value));
         };
 
     private:
         template <detail::not_base_of_property U>
-        void set(U&& value)
+        constexpr void set(U&& value)
         {
             entity_ = std::forward<U>(value);
         }
@@ -1218,11 +1741,193 @@ namespace cpp_property
     template <typename ValueType>
     auto_property(set_auto<void>, ValueType&) -> auto_property<ValueType&, set_only>;
 
+    // property whose accessors are captureless lambdas taking the owner, invoked directly without type erasure
+    // (generic lambdas defer member access until the owner is complete; the setter is optional)
+    template <typename ReturnType, typename Owner, auto Getter, auto Setter = nullptr>
+    requires std::is_empty_v<decltype(Getter)> &&
+             (std::is_null_pointer_v<decltype(Setter)> || std::is_empty_v<decltype(Setter)>)
+    class inline_property
+        : public detail::property_base<
+              inline_property<ReturnType, Owner, Getter, Setter>, ReturnType,
+              std::conditional_t<std::is_null_pointer_v<decltype(Setter)>, void, std::remove_cvref_t<ReturnType>>>
+    {
+        using Base = detail::property_base<
+            inline_property, ReturnType,
+            std::conditional_t<std::is_null_pointer_v<decltype(Setter)>, void, std::remove_cvref_t<ReturnType>>>;
+        friend Base;
+
+        Owner* owner_;
+
+    public:
+        inline_property() = delete;
+        constexpr inline_property(Owner* owner) noexcept : owner_(owner) {}  // NOLINT
+        inline_property(const inline_property&) = delete;
+        inline_property(inline_property&&) = delete;
+        inline_property& operator=(const inline_property&) = delete;
+        inline_property& operator=(inline_property&&) = delete;
+        ~inline_property() = default;
+
+        // assign operator
+        template <detail::base_of_property PropertyType>
+        requires (!std::is_null_pointer_v<decltype(Setter)>) &&
+                 requires(Owner& o, const PropertyType p) { Setter(o, p()); }
+        constexpr decltype(auto) operator=(const PropertyType& prop) const
+        {
+            return Base::operator=(prop());
+        };
+        template <detail::not_base_of_property U>
+        requires (!std::is_null_pointer_v<decltype(Setter)>) && requires(Owner& o, U&& v) {
+            Setter(o, std::forward<U>(v));
+        }
+        constexpr decltype(auto) operator=(U&& value) const
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+    private:
+        [[nodiscard]] constexpr ReturnType get() const
+        {
+            static_assert(!detail::is_dangling_reference<ReturnType, decltype(Getter(*owner_))>,
+                          "getter returns a temporary bound to a reference return type");
+            return Getter(*owner_);
+        }
+        template <detail::not_base_of_property U>
+        constexpr void set(U&& value) const
+        {
+            Setter(*owner_, std::forward<U>(value));
+        }
+    };
+
+    // property whose accessors are (virtual) member functions of the owner, given as member function pointers or as
+    // captureless lambdas calling them by name (virtual_get/virtual_set), so overrides are dispatched by the vtable
+    // (calls by name are devirtualized for final owners; the setter is optional)
+    template <typename ReturnType, typename Owner, auto Getter, auto Setter = nullptr>
+    requires (std::is_member_function_pointer_v<decltype(Getter)> || std::is_empty_v<decltype(Getter)>) &&
+             (std::is_null_pointer_v<decltype(Setter)> || std::is_member_function_pointer_v<decltype(Setter)> ||
+              std::is_empty_v<decltype(Setter)>)
+    class virtual_property
+        : public detail::property_base<
+              virtual_property<ReturnType, Owner, Getter, Setter>, ReturnType,
+              std::conditional_t<std::is_null_pointer_v<decltype(Setter)>, void, std::remove_cvref_t<ReturnType>>>
+    {
+        using Base = detail::property_base<
+            virtual_property, ReturnType,
+            std::conditional_t<std::is_null_pointer_v<decltype(Setter)>, void, std::remove_cvref_t<ReturnType>>>;
+        friend Base;
+
+        Owner* owner_;
+
+        template <auto Accessor, typename... As>
+        static constexpr decltype(auto) call(Owner& owner, As&&... args)
+        {
+            if constexpr (std::is_member_function_pointer_v<decltype(Accessor)>)
+                return (owner.*Accessor)(std::forward<As>(args)...);
+            else
+                return Accessor(owner, std::forward<As>(args)...);
+        }
+
+    public:
+        virtual_property() = delete;
+        constexpr virtual_property(Owner* owner) noexcept : owner_(owner) {}  // NOLINT
+        virtual_property(const virtual_property&) = delete;
+        virtual_property(virtual_property&&) = delete;
+        ~virtual_property() = default;
+
+        // copy assign operator (but not copy)
+        constexpr decltype(auto) operator=(const virtual_property& right) const
+        requires (!std::is_null_pointer_v<decltype(Setter)>)
+        {
+            return Base::operator=(right());
+        }
+
+        // assign operator
+        template <detail::base_of_property PropertyType>
+        requires (!std::is_null_pointer_v<decltype(Setter)>) &&
+                 requires(Owner& o, const PropertyType p) { call<Setter>(o, p()); }
+        constexpr decltype(auto) operator=(const PropertyType& prop) const
+        {
+            return Base::operator=(prop());
+        };
+        template <detail::not_base_of_property U>
+        requires (!std::is_null_pointer_v<decltype(Setter)>) && requires(Owner& o, U&& v) {
+            call<Setter>(o, std::forward<U>(v));
+        }
+        constexpr decltype(auto) operator=(U&& value) const
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+    private:
+        [[nodiscard]] constexpr ReturnType get() const
+        {
+            static_assert(!detail::is_dangling_reference<ReturnType, decltype(call<Getter>(*owner_))>,
+                          "getter returns a temporary bound to a reference return type");
+            return call<Getter>(*owner_);
+        }
+        template <detail::not_base_of_property U>
+        constexpr void set(U&& value) const
+        {
+            call<Setter>(*owner_, std::forward<U>(value));
+        }
+    };
+
+    // class-level property whose accessors are captureless lambdas on static state, for static data members
+    // (an empty class: no per-object storage; the setter is optional)
+    template <typename ReturnType, auto Getter, auto Setter = nullptr>
+    requires std::is_empty_v<decltype(Getter)> &&
+             (std::is_null_pointer_v<decltype(Setter)> || std::is_empty_v<decltype(Setter)>)
+    class static_property
+        : public detail::property_base<
+              static_property<ReturnType, Getter, Setter>, ReturnType,
+              std::conditional_t<std::is_null_pointer_v<decltype(Setter)>, void, std::remove_cvref_t<ReturnType>>>
+    {
+        using Base = detail::property_base<
+            static_property, ReturnType,
+            std::conditional_t<std::is_null_pointer_v<decltype(Setter)>, void, std::remove_cvref_t<ReturnType>>>;
+        friend Base;
+
+    public:
+        constexpr static_property() noexcept {}  // NOLINT
+        static_property(const static_property&) = delete;
+        static_property(static_property&&) = delete;
+        static_property& operator=(const static_property&) = delete;
+        static_property& operator=(static_property&&) = delete;
+        ~static_property() = default;
+
+        // assign operator
+        template <detail::base_of_property PropertyType>
+        requires (!std::is_null_pointer_v<decltype(Setter)>) && requires(const PropertyType p) { Setter(p()); }
+        constexpr decltype(auto) operator=(const PropertyType& prop) const
+        {
+            return Base::operator=(prop());
+        };
+        template <detail::not_base_of_property U>
+        requires (!std::is_null_pointer_v<decltype(Setter)>) && requires(U&& v) { Setter(std::forward<U>(v)); }
+        constexpr decltype(auto) operator=(U&& value) const
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+    private:
+        [[nodiscard]] constexpr ReturnType get() const
+        {
+            static_assert(!detail::is_dangling_reference<ReturnType, decltype(Getter())>,
+                          "getter returns a temporary bound to a reference return type");
+            return Getter();
+        }
+        template <detail::not_base_of_property U>
+        constexpr void set(U&& value) const
+        {
+            Setter(std::forward<U>(value));
+        }
+    };
+
     // close private namespace
     namespace detail
     {
     }
 }  // namespace cpp_property
+#undef CPP_PROPERTY_INTERNAL_NAMESPACE
 
 #ifndef DISABLE_CPP_PROPERTY_FRIENDLY_MACRO
 namespace cpp_property
@@ -1230,17 +1935,5 @@ namespace cpp_property
     inline constexpr auto get = get_auto();
     inline constexpr auto set = set_auto();
 }  // namespace cpp_property
-#define import_cpp_property()                                                                                  \
-    using cpp_property::property, cpp_property::auto_property, cpp_property::get_only, cpp_property::set_only, \
-        cpp_property::get_auto, cpp_property::set_auto, cpp_property::get, cpp_property::set
-#define get_val [this]()->auto
-#define get_cref [this]()->const auto&
-#define get_ref [this]()->auto&
-#define set_val [this](auto value)->void
-#define set_cref [this](const auto& value)->void
-#define set_ref [this](auto& value)->void
-#else
-#define import_cpp_property()                                                                                  \
-    using cpp_property::property, cpp_property::auto_property, cpp_property::get_only, cpp_property::set_only, \
-        cpp_property::get_auto, cpp_property::set_auto
 #endif
+#include "cpp_property/macros.hpp"
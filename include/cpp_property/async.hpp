@@ -0,0 +1,420 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <semaphore>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    template <typename Executor>
+    concept executor = requires(Executor& e, std::coroutine_handle<> h) { e.execute(h); };
+
+    // resume immediately on the current thread
+    class inline_executor
+    {
+    public:
+        void execute(std::coroutine_handle<> h) const { h.resume(); }
+    };
+
+    // resume on one dedicated worker thread, e.g. an I/O thread in front of a slow resource
+    class thread_executor
+    {
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<std::coroutine_handle<>> queue_;
+        bool stop_ = false;
+        std::thread worker_;
+
+        static thread_executor*& current_slot() noexcept
+        {
+            thread_local thread_executor* current = nullptr;
+            return current;
+        }
+        void run()
+        {
+            current_slot() = this;
+            for (;;)
+            {
+                auto lock = std::unique_lock(mutex_);
+                cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (queue_.empty()) return;
+                auto h = queue_.front();
+                queue_.pop_front();
+                lock.unlock();
+                h.resume();
+            }
+        }
+
+    public:
+        thread_executor() : worker_([this] { run(); }) {}
+        thread_executor(const thread_executor&) = delete;
+        thread_executor(thread_executor&&) = delete;
+        thread_executor& operator=(const thread_executor&) = delete;
+        thread_executor& operator=(thread_executor&&) = delete;
+        // pending coroutines are resumed before the worker exits
+        ~thread_executor()
+        {
+            {
+                const auto lock = std::scoped_lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_one();
+            worker_.join();
+        }
+
+        void execute(std::coroutine_handle<> h)
+        {
+            {
+                const auto lock = std::scoped_lock(mutex_);
+                queue_.push_back(h);
+            }
+            cv_.notify_one();
+        }
+        [[nodiscard]] std::thread::id thread_id() const noexcept { return worker_.get_id(); }
+        // executor whose worker is the calling thread, or nullptr
+        [[nodiscard]] static thread_executor* current() noexcept { return current_slot(); }
+    };
+
+    // awaitable which continues the awaiting coroutine on the given executor
+    template <executor Executor>
+    auto schedule_on(Executor& ex) noexcept
+    {
+        struct awaiter
+        {
+            Executor& executor_;
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) const { executor_.execute(h); }
+            void await_resume() const noexcept {}
+        };
+        return awaiter{ex};
+    }
+
+    // lazily started coroutine which resumes its awaiter on completion
+    template <typename T = void>
+    class [[nodiscard]] task
+    {
+        class promise_base
+        {
+            std::coroutine_handle<> continuation_;
+            std::exception_ptr exception_;
+
+            struct final_awaiter
+            {
+                [[nodiscard]] bool await_ready() const noexcept { return false; }
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept
+                {
+                    if (auto c = h.promise().continuation_) return c;
+                    return std::noop_coroutine();
+                }
+                void await_resume() const noexcept {}
+            };
+
+        public:
+            [[nodiscard]] task get_return_object() noexcept
+            {
+                return task(std::coroutine_handle<promise_type>::from_promise(static_cast<promise_type&>(*this)));
+            }
+            [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+            [[nodiscard]] final_awaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+            void set_continuation(std::coroutine_handle<> c) noexcept { continuation_ = c; }
+            void rethrow_if_exception() const
+            {
+                if (exception_) std::rethrow_exception(exception_);
+            }
+        };
+        class value_promise : public promise_base
+        {
+            std::optional<T> value_;
+
+        public:
+            template <typename V>
+            requires std::convertible_to<V&&, T>
+            void return_value(V&& value)
+            {
+                value_.emplace(std::forward<V>(value));
+            }
+            T result()
+            {
+                this->rethrow_if_exception();
+                return std::move(*value_);
+            }
+        };
+        class void_promise : public promise_base
+        {
+        public:
+            void return_void() const noexcept {}
+            void result() const { this->rethrow_if_exception(); }
+        };
+
+    public:
+        using promise_type = std::conditional_t<std::is_void_v<T>, void_promise, value_promise>;
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+
+    public:
+        class awaiter
+        {
+            task task_;
+
+        public:
+            explicit awaiter(task&& t) noexcept : task_(std::move(t)) {}
+            [[nodiscard]] bool await_ready() const noexcept { return !task_.handle_ || task_.handle_.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+            {
+                task_.handle_.promise().set_continuation(continuation);
+                return task_.handle_;
+            }
+            T await_resume() { return task_.handle_.promise().result(); }
+        };
+
+        task() noexcept = default;
+        explicit task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+        task(const task&) = delete;
+        task(task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+        task& operator=(const task&) = delete;
+        task& operator=(task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle_) handle_.destroy();
+                handle_ = std::exchange(other.handle_, {});
+            }
+            return *this;
+        }
+        ~task()
+        {
+            if (handle_) handle_.destroy();
+        }
+
+        awaiter operator co_await() && noexcept { return awaiter(std::move(*this)); }
+    };
+
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            // eagerly started, self-destroying coroutine used by sync_wait
+            struct detached_task
+            {
+                struct promise_type
+                {
+                    [[nodiscard]] detached_task get_return_object() const noexcept { return {}; }
+                    [[nodiscard]] std::suspend_never initial_suspend() const noexcept { return {}; }
+                    [[nodiscard]] std::suspend_never final_suspend() const noexcept { return {}; }
+                    void return_void() const noexcept {}
+                    void unhandled_exception() const noexcept { std::terminate(); }
+                };
+            };
+
+            struct void_result
+            {
+            };
+
+// GCC warns about the switch it generates for coroutine bodies
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-default"
+#endif
+            template <typename T, typename Result>
+            detached_task sync_wait_runner(task<T> t, Result* result, std::exception_ptr* exception,
+                                           std::binary_semaphore* done)
+            {
+                try
+                {
+                    if constexpr (std::is_void_v<T>)
+                        co_await std::move(t);
+                    else
+                        result->emplace(co_await std::move(t));
+                }
+                catch (...)
+                {
+                    *exception = std::current_exception();
+                }
+                done->release();
+            }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+        }  // namespace detail
+    }  // namespace
+
+    // block the calling thread until the task completes (for code outside of coroutines)
+    template <typename T>
+    T sync_wait(task<T> t)
+    {
+        auto result = std::optional<std::conditional_t<std::is_void_v<T>, impl::void_result, T>>();
+        auto exception = std::exception_ptr();
+        auto done = std::binary_semaphore(0);
+        impl::sync_wait_runner(std::move(t), &result, &exception, &done);
+        done.acquire();
+        if (exception) std::rethrow_exception(exception);
+        if constexpr (!std::is_void_v<T>) return std::move(*result);
+    }
+
+    // property whose accessors are coroutines run on an executor: co_await obj.prop, co_await obj.prop.set_async(v)
+    template <typename EntityType, executor Executor = inline_executor>
+    requires (!std::is_reference_v<EntityType>) && (!std::is_void_v<EntityType>)
+    class async_property
+    {
+        const impl::small_function<task<EntityType>()> getter_;       // NOLINT
+        const impl::small_function<task<void>(EntityType)> setter_;  // NOLINT
+        Executor* executor_;
+
+        static Executor& default_executor() noexcept
+        requires std::default_initializable<Executor>
+        {
+            static auto instance = Executor();
+            return instance;
+        }
+
+    public:
+        async_property() = delete;
+        async_property(const async_property&) = delete;
+        async_property(async_property&&) = delete;
+        async_property& operator=(const async_property&) = delete;
+        async_property& operator=(async_property&&) = delete;
+        ~async_property() = default;
+
+        template <typename Getter, typename Setter>
+        requires requires(Getter&& g, Setter&& s) {
+            impl::small_function<task<EntityType>()>{g};
+            impl::small_function<task<void>(EntityType)>{s};
+        }
+        async_property(Executor& ex, Getter&& get_f, Setter&& set_f)
+            : getter_(std::forward<Getter>(get_f)), setter_(std::forward<Setter>(set_f)), executor_(&ex)
+        {
+        }
+        template <typename Getter>
+        requires requires(Getter&& g) { impl::small_function<task<EntityType>()>{g}; }
+        async_property(Executor& ex, Getter&& get_f) : getter_(std::forward<Getter>(get_f)), executor_(&ex)
+        {
+        }
+        template <typename Getter, typename Setter>
+        requires std::default_initializable<Executor> && requires(Getter&& g, Setter&& s) {
+            impl::small_function<task<EntityType>()>{g};
+            impl::small_function<task<void>(EntityType)>{s};
+        }
+        async_property(Getter&& get_f, Setter&& set_f)
+            : getter_(std::forward<Getter>(get_f)), setter_(std::forward<Setter>(set_f)),
+              executor_(&default_executor())
+        {
+        }
+        template <typename Getter>
+        requires std::default_initializable<Executor> &&
+                     requires(Getter&& g) { impl::small_function<task<EntityType>()>{g}; }
+        async_property(Getter&& get_f)  // NOLINT
+            : getter_(std::forward<Getter>(get_f)), executor_(&default_executor())
+        {
+        }
+
+        [[nodiscard]] Executor& get_executor() const noexcept { return *executor_; }
+
+    private:
+        // a caller which already runs on the executor it resumes on continues inline
+        template <typename Resume>
+        static bool needs_resume(Resume* resume_on) noexcept
+        {
+            if constexpr (std::same_as<Resume, thread_executor>)
+                return resume_on != nullptr && resume_on != thread_executor::current();
+            else
+                return resume_on != nullptr;
+        }
+
+// GCC warns about the switch it generates for coroutine bodies
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-default"
+#endif
+        // exceptions of the accessor are rethrown after resuming, on the thread of the awaiting coroutine
+        template <typename Resume>
+        task<EntityType> get_on(Resume* resume_on) const
+        {
+            auto value = std::optional<EntityType>();
+            auto exception = std::exception_ptr();
+            co_await schedule_on(*executor_);
+            try
+            {
+                value.emplace(co_await getter_());
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+            if (needs_resume(resume_on)) co_await schedule_on(*resume_on);
+            if (exception) std::rethrow_exception(exception);
+            co_return std::move(*value);
+        }
+        template <typename Resume>
+        task<void> set_on(EntityType value, Resume* resume_on) const
+        {
+            if (!setter_) throw bad_accessor_call();
+            auto exception = std::exception_ptr();
+            co_await schedule_on(*executor_);
+            try
+            {
+                co_await setter_(std::move(value));
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+            if (needs_resume(resume_on)) co_await schedule_on(*resume_on);
+            if (exception) std::rethrow_exception(exception);
+        }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+    public:
+        // the awaiting coroutine is resumed on the thread_executor it was awaited from, if any,
+        // and otherwise continues on the thread which completed the accessor
+        task<EntityType> get_async() const { return get_on(thread_executor::current()); }
+        task<void> set_async(EntityType value) const { return set_on(std::move(value), thread_executor::current()); }
+        // the awaiting coroutine is resumed on the given executor
+        template <executor Resume>
+        task<EntityType> get_async(Resume& resume_on) const
+        {
+            return get_on(&resume_on);
+        }
+        template <executor Resume>
+        task<void> set_async(EntityType value, Resume& resume_on) const
+        {
+            return set_on(std::move(value), &resume_on);
+        }
+
+        [[nodiscard]] typename task<EntityType>::awaiter operator co_await() const
+        {
+            return typename task<EntityType>::awaiter(get_async());
+        }
+
+        // co_await (obj.prop = value); the returned task is lazy and does nothing unless awaited
+        template <typename U>
+        requires std::convertible_to<U&&, EntityType>
+        task<void> operator=(U&& value) const
+        {
+            return set_async(EntityType(std::forward<U>(value)));
+        }
+    };
+}  // namespace cpp_property
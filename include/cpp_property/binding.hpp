@@ -0,0 +1,236 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    // one-way bindings "target = expr(sources()...)" kept in topological (rank) order;
+    // a change is propagated in waves that evaluate each affected target at most once, after all of its
+    // sources, so no target observes a partially updated state (glitch-free)
+    // (bound properties are held by reference and must outlive the graph)
+    class binding_graph
+    {
+        struct node
+        {
+            std::size_t rank = 0;
+            std::vector<std::size_t> dependents;
+            std::vector<std::size_t> sources;
+            std::function<bool()> evaluate;  // true if the target value changed
+            bool queued = false;
+        };
+
+        std::unordered_map<const void*, std::size_t> index_;
+        std::vector<node> nodes_;
+        std::vector<std::size_t> queue_;  // min-heap on rank
+        std::size_t batch_depth_ = 0;
+
+        std::size_t node_of(const void* prop)
+        {
+            const auto [it, inserted] = index_.try_emplace(prop, nodes_.size());
+            if (inserted) nodes_.emplace_back();
+            return it->second;
+        }
+        // iterative depth-first search with a visited bitmap, so shared (diamond) paths are walked once
+        [[nodiscard]] bool reaches(std::size_t from, std::size_t to) const
+        {
+            auto visited = std::vector<bool>(nodes_.size());
+            auto stack = std::vector<std::size_t>{from};
+            visited[from] = true;
+            while (!stack.empty())
+            {
+                const auto n = stack.back();
+                stack.pop_back();
+                if (n == to) return true;
+                for (const auto d : nodes_[n].dependents)
+                {
+                    if (visited[d]) continue;
+                    visited[d] = true;
+                    stack.push_back(d);
+                }
+            }
+            return false;
+        }
+        // raise the rank of n to at least rank and relax the ranks downstream in topological order, so every
+        // reachable node is visited once
+        void raise_rank(std::size_t n, std::size_t rank)
+        {
+            if (nodes_[n].rank >= rank) return;
+            nodes_[n].rank = rank;
+
+            // reverse post-order of the nodes reachable from n
+            auto order = std::vector<std::size_t>();
+            auto visited = std::vector<bool>(nodes_.size());
+            auto stack = std::vector<std::pair<std::size_t, std::size_t>>{{n, 0}};  // node, next dependent
+            visited[n] = true;
+            while (!stack.empty())
+            {
+                auto& [m, next] = stack.back();
+                if (next < nodes_[m].dependents.size())
+                {
+                    const auto d = nodes_[m].dependents[next++];
+                    if (visited[d]) continue;
+                    visited[d] = true;
+                    stack.emplace_back(d, 0);
+                    continue;
+                }
+                order.push_back(m);
+                stack.pop_back();
+            }
+            for (const auto m : order | std::views::reverse)
+                for (const auto d : nodes_[m].dependents) nodes_[d].rank = std::max(nodes_[d].rank, nodes_[m].rank + 1);
+        }
+
+        void enqueue_dependents(std::size_t n)
+        {
+            const auto later = [this](auto l, auto r) { return nodes_[l].rank > nodes_[r].rank; };
+            for (const auto d : nodes_[n].dependents)
+            {
+                if (std::exchange(nodes_[d].queued, true)) continue;
+                queue_.push_back(d);
+                std::ranges::push_heap(queue_, later);
+            }
+        }
+        void propagate()
+        {
+            // if an evaluation throws, drop the rest of the wave so that the queued flags do not block later waves
+            struct guard
+            {
+                binding_graph& graph;
+                explicit guard(binding_graph& g) : graph(g) {}
+                guard(const guard&) = delete;
+                guard(guard&&) = delete;
+                guard& operator=(const guard&) = delete;
+                guard& operator=(guard&&) = delete;
+                ~guard()
+                {
+                    for (const auto n : graph.queue_) graph.nodes_[n].queued = false;
+                    graph.queue_.clear();
+                }
+            };
+            const auto g = guard(*this);
+            const auto later = [this](auto l, auto r) { return nodes_[l].rank > nodes_[r].rank; };
+            while (!queue_.empty())
+            {
+                std::ranges::pop_heap(queue_, later);
+                const auto n = queue_.back();
+                queue_.pop_back();
+                nodes_[n].queued = false;
+                if (nodes_[n].evaluate()) enqueue_dependents(n);
+            }
+        }
+
+    public:
+        binding_graph() = default;
+        binding_graph(const binding_graph&) = delete;
+        binding_graph(binding_graph&&) = default;
+        binding_graph& operator=(const binding_graph&) = delete;
+        binding_graph& operator=(binding_graph&&) = default;
+        ~binding_graph() = default;
+
+        // bind target to expr over the sources and evaluate it once;
+        // throws std::invalid_argument if target is already bound or the binding would form a cycle
+        template <impl::base_of_property Target, typename Expr, impl::base_of_property... Sources>
+        requires std::invocable<Expr&, decltype(std::declval<const Sources&>()())...> &&
+                 requires(Target& t, Expr& e, const Sources&... s) { t = std::invoke(e, s()...); }
+        void bind(Target& target, Expr&& expr, const Sources&... sources)
+        {
+            const auto t = node_of(std::addressof(target));
+            const auto s = std::array<std::size_t, sizeof...(Sources)>{node_of(std::addressof(sources))...};
+            if (nodes_[t].evaluate)
+                throw std::invalid_argument("cpp_property::binding_graph: target already bound");
+            if (std::ranges::any_of(s, [&](auto n) { return reaches(t, n); }))
+                throw std::invalid_argument("cpp_property::binding_graph: binding forms a cycle");
+
+            for (const auto n : s)
+            {
+                nodes_[n].dependents.push_back(t);
+                nodes_[t].sources.push_back(n);
+                raise_rank(t, nodes_[n].rank + 1);
+            }
+            nodes_[t].evaluate = [&target, expr = std::forward<Expr>(expr), &sources...]() -> bool {
+                auto value = std::invoke(expr, sources()...);
+                if constexpr (std::equality_comparable_with<decltype(target()), decltype(value)>)
+                {
+                    if (std::equal_to<>()(target(), value)) return false;
+                }
+                target = std::move(value);
+                return true;
+            };
+            if (nodes_[t].evaluate()) notify(target);
+        }
+
+        // remove the binding of target (its value is kept)
+        template <impl::base_of_property Target>
+        void unbind(const Target& target)
+        {
+            const auto it = index_.find(std::addressof(target));
+            if (it == index_.end()) return;
+            auto& t = nodes_[it->second];
+            for (const auto n : t.sources) std::erase(nodes_[n].dependents, it->second);
+            t.sources.clear();
+            t.evaluate = nullptr;
+        }
+
+        // propagate a change of prop made outside the graph
+        template <impl::base_of_property Property>
+        void notify(const Property& prop)
+        {
+            const auto it = index_.find(std::addressof(prop));
+            if (it == index_.end()) return;
+            enqueue_dependents(it->second);
+            if (batch_depth_ == 0) propagate();
+        }
+
+        // assign through the property's setter and propagate the change
+        template <impl::base_of_property Property, typename U>
+        requires requires(Property& p, U&& v) { p = std::forward<U>(v); }
+        void set(Property& prop, U&& value)
+        {
+            prop = std::forward<U>(value);
+            notify(prop);
+        }
+
+        // run func and propagate all changes made in it as one wave
+        template <typename Func>
+        requires std::invocable<Func&>
+        void batch(Func&& func)
+        {
+            struct guard
+            {
+                binding_graph& graph;
+                explicit guard(binding_graph& g) : graph(g) { ++graph.batch_depth_; }
+                guard(const guard&) = delete;
+                guard(guard&&) = delete;
+                guard& operator=(const guard&) = delete;
+                guard& operator=(guard&&) = delete;
+                ~guard() { --graph.batch_depth_; }
+            };
+            {
+                const auto g = guard(*this);
+                func();
+            }
+            if (batch_depth_ == 0) propagate();
+        }
+    };
+}  // namespace cpp_property
@@ -0,0 +1,197 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    // runs the staged writes of coalesced setters on the thread that calls poll() or flush()
+    class coalescer
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        class slot
+        {
+            friend class coalescer;
+            clock::time_point last_run_ = clock::time_point::min();
+
+        public:
+            slot() = default;
+            slot(const slot&) = delete;
+            slot(slot&&) = delete;
+            slot& operator=(const slot&) = delete;
+            slot& operator=(slot&&) = delete;
+            virtual ~slot() = default;
+
+            [[nodiscard]] virtual bool pending() const noexcept = 0;
+            // apply the latest staged value, if any
+            virtual void run() = 0;
+        };
+
+    private:
+        clock::duration interval_;
+        std::mutex mutex_;
+        std::vector<std::weak_ptr<slot>> slots_;
+        std::mutex run_mutex_;
+        std::vector<std::shared_ptr<slot>> scratch_;
+
+        template <typename Pred>
+        std::size_t run_if(Pred pred)
+        {
+            const auto run_lock = std::scoped_lock(run_mutex_);
+            {
+                // setters run outside the registry lock so that they may create coalesced properties
+                const auto lock = std::scoped_lock(mutex_);
+                std::erase_if(slots_, [](const auto& s) { return s.expired(); });
+                for (const auto& s : slots_)
+                    if (auto p = s.lock(); p != nullptr && p->pending()) scratch_.push_back(std::move(p));
+            }
+            auto count = std::size_t{0};
+            const auto now = clock::now();
+            for (const auto& s : scratch_)
+            {
+                if (!pred(*s, now)) continue;
+                s->last_run_ = now;
+                s->run();
+                ++count;
+            }
+            scratch_.clear();
+            return count;
+        }
+
+    public:
+        explicit coalescer(clock::duration interval = clock::duration::zero()) : interval_(interval) {}
+        coalescer(const coalescer&) = delete;
+        coalescer(coalescer&&) = delete;
+        coalescer& operator=(const coalescer&) = delete;
+        coalescer& operator=(coalescer&&) = delete;
+        ~coalescer() = default;
+
+        void attach(const std::shared_ptr<slot>& s)
+        {
+            const auto lock = std::scoped_lock(mutex_);
+            slots_.push_back(s);
+        }
+
+        // run each pending setter whose last run is at least one interval ago; returns the number of runs
+        std::size_t poll()
+        {
+            return run_if([this](const slot& s, clock::time_point now) { return s.last_run_ <= now - interval_; });
+        }
+        // run every pending setter now
+        std::size_t flush()
+        {
+            return run_if([](const slot&, clock::time_point) { return true; });
+        }
+    };
+
+    // last-writer-wins staging of one value (lock-free when std::atomic<T> is)
+    template <typename T, typename Func>
+    class coalescing_slot : public coalescer::slot
+    {
+        Func setter_;
+        mutable std::mutex mutex_;
+        std::optional<T> staged_;
+
+    public:
+        explicit coalescing_slot(Func setter) : setter_(std::move(setter)) {}
+
+        template <typename U>
+        void stage(U&& value)
+        {
+            const auto lock = std::scoped_lock(mutex_);
+            staged_ = std::forward<U>(value);
+        }
+        [[nodiscard]] bool pending() const noexcept override
+        {
+            const auto lock = std::scoped_lock(mutex_);
+            return staged_.has_value();
+        }
+        void run() override
+        {
+            auto value = std::optional<T>();
+            {
+                const auto lock = std::scoped_lock(mutex_);
+                value.swap(staged_);
+            }
+            if (value) std::invoke(setter_, std::move(*value));
+        }
+    };
+    template <typename T, typename Func>
+    requires std::is_trivially_copyable_v<T> && std::atomic<T>::is_always_lock_free
+    class coalescing_slot<T, Func> : public coalescer::slot
+    {
+        Func setter_;
+        std::atomic<T> staged_ = T();
+        std::atomic<bool> dirty_ = false;
+
+    public:
+        explicit coalescing_slot(Func setter) : setter_(std::move(setter)) {}
+
+        template <typename U>
+        void stage(U&& value) noexcept
+        {
+            staged_.store(static_cast<T>(std::forward<U>(value)), std::memory_order_relaxed);
+            dirty_.store(true, std::memory_order_release);
+        }
+        [[nodiscard]] bool pending() const noexcept override { return dirty_.load(std::memory_order_acquire); }
+        void run() override
+        {
+            // a write racing with run() is applied again by the next run (still the latest value)
+            if (dirty_.exchange(false, std::memory_order_acquire))
+                std::invoke(setter_, staged_.load(std::memory_order_relaxed));
+        }
+    };
+
+    // setter wrapper which only stages the value; the wrapped setter runs from the coalescer
+    template <typename T, typename Func>
+    class coalesced_function
+    {
+        std::shared_ptr<coalescing_slot<T, Func>> slot_;
+
+    public:
+        template <typename F>
+        coalesced_function(coalescer& owner, F&& func)
+            : slot_(std::make_shared<coalescing_slot<T, Func>>(Func(std::forward<F>(func))))
+        {
+            owner.attach(slot_);
+        }
+
+        template <typename U>
+        requires std::convertible_to<U&&, T>
+        void operator()(U&& value) const
+        {
+            slot_->stage(std::forward<U>(value));
+        }
+    };
+
+    // stage writes of value type T for the coalescer instead of calling func on every write
+    // (reads see the last applied value; do not destroy the owner of func while a poll runs it)
+    template <typename T, typename Func>
+    requires std::invocable<std::remove_cvref_t<Func>&, T>
+    auto coalesced(coalescer& owner, Func&& func)
+    {
+        return coalesced_function<T, std::remove_cvref_t<Func>>(owner, std::forward<Func>(func));
+    }
+}  // namespace cpp_property
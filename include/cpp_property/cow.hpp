@@ -0,0 +1,165 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            template <typename RefCount>
+            concept atomic_ref_count = requires(RefCount& c) {
+                c.fetch_add(1, std::memory_order_relaxed);
+                c.fetch_sub(1, std::memory_order_acq_rel);
+                c.load(std::memory_order_acquire);
+            };
+            template <typename RefCount>
+            concept ref_count = atomic_ref_count<RefCount> || std::unsigned_integral<RefCount>;
+
+            template <typename T, ref_count RefCount>
+            struct cow_block
+            {
+                RefCount count;
+                T value;
+
+                template <typename... Args>
+                explicit cow_block(Args&&... args) : count(1), value(std::forward<Args>(args)...)
+                {
+                }
+
+                void acquire() noexcept
+                {
+                    if constexpr (atomic_ref_count<RefCount>)
+                        count.fetch_add(1, std::memory_order_relaxed);
+                    else
+                        ++count;
+                }
+                // true if this was the last reference
+                [[nodiscard]] bool release() noexcept
+                {
+                    if constexpr (atomic_ref_count<RefCount>)
+                        return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+                    else
+                        return --count == 0;
+                }
+                [[nodiscard]] std::size_t use_count() const noexcept
+                {
+                    if constexpr (atomic_ref_count<RefCount>)
+                        return count.load(std::memory_order_acquire);
+                    else
+                        return count;
+                }
+            };
+        }  // namespace detail
+    }  // namespace
+
+    // property whose copies share the backing value until one of them is written
+    // (RefCount = std::size_t when copies never cross threads)
+    template <typename EntityType, impl::ref_count RefCount = std::atomic<std::size_t>>
+    requires (!std::is_reference_v<EntityType>) && std::copy_constructible<EntityType>
+    class cow_property
+        : public impl::property_base<cow_property<EntityType, RefCount>, const EntityType&, EntityType>,
+          public impl::mutable_operators<cow_property<EntityType, RefCount>>
+    {
+        using Base = impl::property_base<cow_property<EntityType, RefCount>, const EntityType&, EntityType>;
+        friend Base;
+
+        using Block = impl::cow_block<EntityType, RefCount>;
+        Block* block_;
+
+        void release() noexcept
+        {
+            if (block_->release()) delete block_;
+        }
+        // clone the shared value before the first write
+        EntityType& unique_value()
+        {
+            if (block_->use_count() != 1)
+            {
+                auto* clone = new Block(std::as_const(block_->value));
+                release();
+                block_ = clone;
+            }
+            return block_->value;
+        }
+
+    public:
+        cow_property() : block_(new Block()) {}
+        cow_property(const cow_property& other) noexcept : Base(), block_(other.block_) { block_->acquire(); }
+        // the source keeps sharing the value, so it stays usable after the move
+        cow_property(cow_property&& other) noexcept : Base(), block_(other.block_) { block_->acquire(); }
+        template <typename V>
+        requires std::constructible_from<EntityType, V&&> &&
+                 (!std::same_as<std::remove_cvref_t<V>, cow_property>)
+        explicit cow_property(V&& init) : block_(new Block(std::forward<V>(init)))
+        {
+        }
+        ~cow_property() { release(); }
+
+        // copy assign operator (shares the value)
+        cow_property& operator=(const cow_property& right) noexcept
+        {
+            right.block_->acquire();
+            release();
+            block_ = right.block_;
+            return *this;
+        }
+        cow_property& operator=(cow_property&& right) noexcept { return *this = std::as_const(right); }
+
+        // assign operator
+        template <impl::base_of_property PropertyType>
+        requires requires(EntityType& e, const PropertyType p) { e = p(); }
+        decltype(auto) operator=(const PropertyType& prop)
+        {
+            return Base::operator=(prop());
+        };
+        template <impl::not_base_of_property U>
+        requires requires(EntityType& e, U&& v) { e = std::forward<U>(v); }
+        decltype(auto) operator=(U&& value)
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+        // mutate the value in place, cloning it first if it is shared
+        template <typename Func>
+        requires std::invocable<Func&, EntityType&>
+        void modify(Func&& func)
+        {
+            func(unique_value());
+        }
+
+        [[nodiscard]] std::size_t use_count() const noexcept { return block_->use_count(); }
+        [[nodiscard]] bool unique() const noexcept { return use_count() == 1; }
+
+    private:
+        [[nodiscard]] const EntityType& get() const noexcept { return block_->value; }
+        template <impl::not_base_of_property U>
+        void set(U&& value)
+        {
+            if (block_->use_count() == 1)
+            {
+                block_->value = std::forward<U>(value);
+                return;
+            }
+            // a shared value is replaced, not cloned
+            auto* replacement = new Block(std::forward<U>(value));
+            release();
+            block_ = replacement;
+        }
+    };
+}  // namespace cpp_property
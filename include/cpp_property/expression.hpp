@@ -0,0 +1,240 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    struct expression_base
+    {
+    };
+
+    template <typename T>
+    concept expression_node = std::derived_from<std::remove_cvref_t<T>, expression_base>;
+
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            template <typename T>
+            concept scalar_operand = std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+            template <typename T>
+            concept indexable = requires(const T& t, std::size_t i) {
+                t[i];
+                { std::size(t) } -> std::convertible_to<std::size_t>;
+            };
+
+            template <typename T>
+            concept sized_expression = expression_node<T> && requires(const T& t) { t.size(); };
+
+            // sequence container which an expression can be evaluated into: resizable and indexable, growable by
+            // push_back, or of fixed size like std::array (not associative containers such as std::map)
+            template <typename Container, typename Element>
+            concept expression_container =
+                std::default_initializable<Container> && requires { typename Container::value_type; } &&
+                std::convertible_to<Element, typename Container::value_type> &&
+                (requires(Container& c, std::size_t i) {
+                    c.resize(i);
+                    { c[i] } -> std::same_as<typename Container::value_type&>;
+                } || requires(Container& c, typename Container::value_type v) { c.push_back(std::move(v)); } ||
+                 requires(Container& c, std::size_t i) {
+                     std::tuple_size<Container>::value;
+                     { c[i] } -> std::same_as<typename Container::value_type&>;
+                 });
+
+            // evaluate all elements in one loop
+            template <typename Container, typename Expression>
+            Container evaluate(const Expression& e)
+            {
+                auto out = Container();
+                const auto n = e.size();
+                if constexpr (requires { out.resize(n); })
+                {
+                    out.resize(n);
+                    for (std::size_t i = 0; i < n; ++i) out[i] = e[i];
+                }
+                else if constexpr (requires { out.push_back(e[0]); })
+                {
+                    if constexpr (requires { out.reserve(n); }) out.reserve(n);
+                    for (std::size_t i = 0; i < n; ++i) out.push_back(e[i]);
+                }
+                else
+                {
+                    if (std::size(out) != n) throw std::length_error("expression and container sizes differ");
+                    for (std::size_t i = 0; i < n; ++i) out[i] = e[i];
+                }
+                return out;
+            }
+        }  // namespace detail
+    }  // namespace
+
+    // element-wise view of a container (held by reference if the getter returns one)
+    template <typename T>
+    class expression_leaf : public expression_base
+    {
+        T value_;
+
+    public:
+        explicit expression_leaf(T value) : value_(std::forward<T>(value)) {}
+        [[nodiscard]] decltype(auto) operator[](std::size_t i) const { return value_[i]; }
+        [[nodiscard]] std::size_t size() const { return std::size(value_); }
+    };
+
+    // scalar broadcast to every element
+    template <typename T>
+    class expression_scalar : public expression_base
+    {
+        T value_;
+
+    public:
+        explicit expression_scalar(T value) : value_(value) {}
+        [[nodiscard]] T operator[](std::size_t) const { return value_; }
+    };
+
+    template <typename Op, typename L, typename R>
+    class expression_binary : public expression_base
+    {
+        L left_;
+        R right_;
+
+    public:
+        expression_binary(L left, R right) : left_(std::move(left)), right_(std::move(right))
+        {
+            static_cast<void>(size());
+        }
+        [[nodiscard]] decltype(auto) operator[](std::size_t i) const { return Op{}(left_[i], right_[i]); }
+        // checked on construction and again on evaluation, as referenced containers may be resized in between
+        [[nodiscard]] std::size_t size() const
+        {
+            if constexpr (impl::sized_expression<L> && impl::sized_expression<R>)
+            {
+                const auto n = left_.size();
+                if (n != right_.size()) throw std::length_error("expression operands differ in size");
+                return n;
+            }
+            else if constexpr (impl::sized_expression<L>)
+                return left_.size();
+            else
+                return right_.size();
+        }
+
+        template <typename Container>
+        requires impl::expression_container<Container, decltype(std::declval<const expression_binary&>()[0])>
+        operator Container() const  // NOLINT
+        {
+            return impl::evaluate<Container>(*this);
+        }
+    };
+
+    template <typename Op, typename E>
+    class expression_unary : public expression_base
+    {
+        E operand_;
+
+    public:
+        explicit expression_unary(E operand) : operand_(std::move(operand)) {}
+        [[nodiscard]] decltype(auto) operator[](std::size_t i) const { return Op{}(operand_[i]); }
+        [[nodiscard]] std::size_t size() const { return operand_.size(); }
+
+        template <typename Container>
+        requires impl::expression_container<Container, decltype(std::declval<const expression_unary&>()[0])>
+        operator Container() const  // NOLINT
+        {
+            return impl::evaluate<Container>(*this);
+        }
+    };
+
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            template <typename T>
+            auto to_operand(T&& t)
+            {
+                if constexpr (expression_node<T>)
+                    return std::remove_cvref_t<T>(std::forward<T>(t));
+                else
+                    return expression_scalar<std::remove_cvref_t<T>>(t);
+            }
+
+            template <typename Op, typename L, typename R>
+            auto make_binary(L&& left, R&& right)
+            {
+                using LeftOperand = decltype(to_operand(std::forward<L>(left)));
+                using RightOperand = decltype(to_operand(std::forward<R>(right)));
+                return expression_binary<Op, LeftOperand, RightOperand>(to_operand(std::forward<L>(left)),
+                                                                        to_operand(std::forward<R>(right)));
+            }
+
+            template <typename L, typename R>
+            concept expression_operands = (expression_node<L> && (expression_node<R> || scalar_operand<R>)) ||
+                                          (scalar_operand<L> && expression_node<R>);
+        }  // namespace detail
+    }  // namespace
+
+#pragma region expression operators
+    template <typename L, typename R>
+    requires impl::expression_operands<L, R>
+    auto operator+(L&& left, R&& right)
+    {
+        return impl::make_binary<std::plus<>>(std::forward<L>(left), std::forward<R>(right));
+    }
+    template <typename L, typename R>
+    requires impl::expression_operands<L, R>
+    auto operator-(L&& left, R&& right)
+    {
+        return impl::make_binary<std::minus<>>(std::forward<L>(left), std::forward<R>(right));
+    }
+    template <typename L, typename R>
+    requires impl::expression_operands<L, R>
+    auto operator*(L&& left, R&& right)
+    {
+        return impl::make_binary<std::multiplies<>>(std::forward<L>(left), std::forward<R>(right));
+    }
+    template <typename L, typename R>
+    requires impl::expression_operands<L, R>
+    auto operator/(L&& left, R&& right)
+    {
+        return impl::make_binary<std::divides<>>(std::forward<L>(left), std::forward<R>(right));
+    }
+    template <expression_node E>
+    auto operator-(E&& operand)
+    {
+        return expression_unary<std::negate<>, std::remove_cvref_t<E>>(std::forward<E>(operand));
+    }
+#pragma endregion
+
+    // start a lazily evaluated element-wise expression from a container-valued property
+    template <impl::base_of_property Property>
+    requires impl::indexable<std::remove_cvref_t<decltype(std::declval<const Property&>()())>>
+    auto lazy(const Property& prop)
+    {
+        return expression_leaf<decltype(prop())>(prop());
+    }
+    // or from a container which outlives the expression
+    template <impl::not_base_of_property Container>
+    requires impl::indexable<Container>
+    auto lazy(const Container& container)
+    {
+        return expression_leaf<const Container&>(container);
+    }
+    // a temporary would dangle before the expression is evaluated
+    template <impl::not_base_of_property Container>
+    requires impl::indexable<Container>
+    auto lazy(const Container&& container) = delete;
+}  // namespace cpp_property
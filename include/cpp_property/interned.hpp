@@ -0,0 +1,149 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    // process-wide set of unique strings; interned strings are never released, so their addresses are stable
+    template <typename StringType = std::string>
+    class intern_table
+    {
+    public:
+        using view_type = std::basic_string_view<typename StringType::value_type, typename StringType::traits_type>;
+
+    private:
+        struct hash
+        {
+            using is_transparent = void;
+            std::size_t operator()(view_type s) const noexcept { return std::hash<view_type>{}(s); }
+        };
+        struct equal
+        {
+            using is_transparent = void;
+            bool operator()(view_type l, view_type r) const noexcept { return l == r; }
+        };
+
+        mutable std::shared_mutex mutex_;
+        std::unordered_set<StringType, hash, equal> strings_;
+
+        intern_table() = default;
+
+    public:
+        intern_table(const intern_table&) = delete;
+        intern_table(intern_table&&) = delete;
+        intern_table& operator=(const intern_table&) = delete;
+        intern_table& operator=(intern_table&&) = delete;
+        ~intern_table() = default;
+
+        static intern_table& instance()
+        {
+            static auto table = intern_table();
+            return table;
+        }
+
+        // return the unique copy of the string, inserting it on first use
+        [[nodiscard]] const StringType* intern(view_type s)
+        {
+            {
+                const auto lock = std::shared_lock(mutex_);
+                if (const auto it = strings_.find(s); it != strings_.end()) return &*it;
+            }
+            const auto lock = std::scoped_lock(mutex_);
+            return &*strings_.emplace(s).first;
+        }
+        [[nodiscard]] std::size_t size() const
+        {
+            const auto lock = std::shared_lock(mutex_);
+            return strings_.size();
+        }
+    };
+
+    // string property which stores a handle into the intern table instead of its own copy
+    template <typename StringType = std::string>
+    requires std::same_as<StringType, std::basic_string<typename StringType::value_type,
+                                                        typename StringType::traits_type,
+                                                        typename StringType::allocator_type>>
+    class interned_property
+        : public impl::property_base<interned_property<StringType>,
+                                     typename intern_table<StringType>::view_type,
+                                     typename intern_table<StringType>::view_type>
+    {
+        using ViewType = typename intern_table<StringType>::view_type;
+        using Base = impl::property_base<interned_property<StringType>, ViewType, ViewType>;
+        friend Base;
+
+        const StringType* handle_ = empty();
+
+        static const StringType* empty()
+        {
+            static const auto* const handle = intern_table<StringType>::instance().intern(ViewType());
+            return handle;
+        }
+
+    public:
+        interned_property() = default;
+        interned_property(const interned_property& other) noexcept : Base(), handle_(other.handle_) {}
+        interned_property(interned_property&& other) noexcept : Base(), handle_(other.handle_) {}
+        explicit interned_property(ViewType init) : handle_(intern_table<StringType>::instance().intern(init)) {}
+        ~interned_property() = default;
+
+        // copy assign operator (copies the handle)
+        interned_property& operator=(const interned_property& right) noexcept
+        {
+            handle_ = right.handle_;
+            return *this;
+        }
+        interned_property& operator=(interned_property&& right) noexcept
+        {
+            handle_ = right.handle_;
+            return *this;
+        }
+
+        // assign operator
+        template <impl::base_of_property PropertyType>
+        requires std::convertible_to<decltype(std::declval<const PropertyType&>()()), ViewType>
+        decltype(auto) operator=(const PropertyType& prop)
+        {
+            return Base::operator=(ViewType(prop()));
+        };
+        template <impl::not_base_of_property U>
+        requires std::convertible_to<U&&, ViewType>
+        decltype(auto) operator=(U&& value)
+        {
+            return Base::operator=(ViewType(std::forward<U>(value)));
+        };
+
+        // the interned string, valid for the lifetime of the program
+        [[nodiscard]] const StringType& str() const noexcept { return *handle_; }
+        [[nodiscard]] const StringType* handle() const noexcept { return handle_; }
+
+        // equal strings share one handle
+        friend bool operator==(const interned_property& l, const interned_property& r) noexcept
+        {
+            return l.handle_ == r.handle_;
+        }
+
+    private:
+        [[nodiscard]] ViewType get() const noexcept { return *handle_; }
+        void set(ViewType value) { handle_ = intern_table<StringType>::instance().intern(value); }
+    };
+}  // namespace cpp_property
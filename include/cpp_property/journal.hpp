@@ -0,0 +1,276 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    // undo/redo history of raw writes, recorded into a reusable bump arena
+    // (targets must outlive their records; only trivially copyable values are journaled)
+    class journal
+    {
+        struct record
+        {
+            record* prev;
+            record* next;
+            void* target;
+            std::size_t size;
+            std::uint64_t step;
+            std::size_t chunk;  // arena position just after this record
+            std::size_t end;
+
+            [[nodiscard]] std::byte* payload() noexcept { return reinterpret_cast<std::byte*>(this + 1); }
+            // exchange the recorded value and the current value, so the same record serves undo and redo
+            void swap() noexcept { std::swap_ranges(payload(), payload() + size, static_cast<std::byte*>(target)); }
+        };
+
+        struct chunk
+        {
+            std::unique_ptr<std::byte[]> data;
+            std::size_t size;
+        };
+
+        std::size_t chunk_size_;
+        std::vector<chunk> chunks_;
+        std::size_t chunk_ = 0;
+        std::size_t offset_ = 0;
+        record* first_ = nullptr;
+        record* last_ = nullptr;    // newest record (may be undone)
+        record* cursor_ = nullptr;  // newest applied record
+        std::uint64_t step_ = 0;
+
+        static journal*& active_ref() noexcept
+        {
+            thread_local journal* active = nullptr;
+            return active;
+        }
+
+        static constexpr std::size_t align_up(std::size_t n) noexcept
+        {
+            return (n + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        }
+
+        // chunks are kept after truncation and reused, so steady-state recording does not allocate
+        void* allocate(std::size_t bytes)
+        {
+            while (chunk_ < chunks_.size() && offset_ + bytes > chunks_[chunk_].size)
+            {
+                ++chunk_;
+                offset_ = 0;
+            }
+            if (chunk_ == chunks_.size())
+                chunks_.push_back({std::make_unique<std::byte[]>(std::max(bytes, chunk_size_)),
+                                   std::max(bytes, chunk_size_)});
+            auto* p = chunks_[chunk_].data.get() + offset_;
+            offset_ = align_up(offset_ + bytes);
+            return p;
+        }
+
+        // drop the undone records in O(1) by rewinding the arena
+        void truncate_redo() noexcept
+        {
+            if (cursor_ == last_) return;
+            if (cursor_ == nullptr)
+            {
+                chunk_ = 0;
+                offset_ = 0;
+                first_ = nullptr;
+            }
+            else
+            {
+                chunk_ = cursor_->chunk;
+                offset_ = cursor_->end;
+                cursor_->next = nullptr;
+            }
+            last_ = cursor_;
+        }
+
+    public:
+        explicit journal(std::size_t chunk_size = 64 * 1024) : chunk_size_(chunk_size) {}
+        journal(const journal&) = delete;
+        journal(journal&&) = delete;
+        journal& operator=(const journal&) = delete;
+        journal& operator=(journal&&) = delete;
+        ~journal()
+        {
+            if (active_ref() == this) active_ref() = nullptr;
+        }
+
+        // makes a journal the recording target of the current thread while alive
+        class scope
+        {
+            journal* previous_;
+
+        public:
+            explicit scope(journal& j) noexcept : previous_(std::exchange(active_ref(), &j)) {}
+            scope(const scope&) = delete;
+            scope(scope&&) = delete;
+            scope& operator=(const scope&) = delete;
+            scope& operator=(scope&&) = delete;
+            ~scope() { active_ref() = previous_; }
+        };
+
+        [[nodiscard]] static journal* active() noexcept { return active_ref(); }
+
+        // record the current value of target into the active journal, if any
+        template <typename T>
+        requires std::is_trivially_copyable_v<T>
+        static void record_write(T& target)
+        {
+            if (auto* j = active_ref(); j != nullptr) [[unlikely]]
+                j->push(target);
+        }
+
+        template <typename T>
+        requires std::is_trivially_copyable_v<T>
+        void push(T& target)
+        {
+            truncate_redo();
+            auto* r = ::new (allocate(sizeof(record) + sizeof(T)))
+                record{last_, nullptr, std::addressof(target), sizeof(T), step_, 0, 0};
+            std::memcpy(r->payload(), std::addressof(target), sizeof(T));
+            r->chunk = chunk_;
+            r->end = offset_;
+            if (last_ != nullptr)
+                last_->next = r;
+            else
+                first_ = r;
+            last_ = cursor_ = r;
+        }
+
+        // close the current undo step; following writes form the next step
+        void commit() noexcept
+        {
+            if (cursor_ != nullptr && cursor_->step == step_) ++step_;
+        }
+
+        [[nodiscard]] bool can_undo() const noexcept { return cursor_ != nullptr; }
+        [[nodiscard]] bool can_redo() const noexcept { return cursor_ != last_; }
+
+        // revert the writes of the newest applied step
+        bool undo() noexcept
+        {
+            if (cursor_ == nullptr) return false;
+            const auto step = cursor_->step;
+            while (cursor_ != nullptr && cursor_->step == step)
+            {
+                cursor_->swap();
+                cursor_ = cursor_->prev;
+            }
+            commit();
+            return true;
+        }
+        // reapply the writes of the oldest undone step
+        bool redo() noexcept
+        {
+            auto* next = cursor_ != nullptr ? cursor_->next : first_;
+            if (next == nullptr) return false;
+            const auto step = next->step;
+            while (next != nullptr && next->step == step)
+            {
+                next->swap();
+                cursor_ = next;
+                next = next->next;
+            }
+            step_ = step + 1;
+            return true;
+        }
+
+        // forget the whole history in O(1), keeping the arena for reuse
+        void clear() noexcept
+        {
+            chunk_ = 0;
+            offset_ = 0;
+            first_ = last_ = cursor_ = nullptr;
+            ++step_;
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept
+        {
+            auto sum = std::size_t{0};
+            for (const auto& c : chunks_) sum += c.size;
+            return sum;
+        }
+    };
+
+    // auto-implemented property whose writes are recorded into the active journal
+    template <typename EntityType>
+    requires std::is_trivially_copyable_v<EntityType> && (!std::is_const_v<EntityType>)
+    class journaled_property
+        : public impl::property_base<journaled_property<EntityType>, const EntityType&, EntityType>,
+          public impl::mutable_operators<journaled_property<EntityType>>
+    {
+        using Base = impl::property_base<journaled_property<EntityType>, const EntityType&, EntityType>;
+        friend Base;
+
+        EntityType entity_ = {};
+
+    public:
+        journaled_property() = default;
+        template <typename V>
+        requires std::constructible_from<EntityType, V&&> &&
+                 (!std::same_as<std::remove_cvref_t<V>, journaled_property>)
+        explicit journaled_property(V&& init) : entity_(std::forward<V>(init))
+        {
+        }
+        journaled_property(const journaled_property& other) noexcept : Base(), entity_(other.entity_) {}
+        journaled_property(journaled_property&& other) noexcept : Base(), entity_(other.entity_) {}
+        ~journaled_property() = default;
+
+        // copy assign operator (recorded like any other write)
+        journaled_property& operator=(const journaled_property& right)
+        {
+            set(right.entity_);
+            return *this;
+        }
+        journaled_property& operator=(journaled_property&& right) { return *this = std::as_const(right); }
+
+        // assign operator
+        template <impl::base_of_property PropertyType>
+        requires requires(EntityType& e, const PropertyType p) { e = p(); }
+        decltype(auto) operator=(const PropertyType& prop)
+        {
+            return Base::operator=(prop());
+        };
+        template <impl::not_base_of_property U>
+        requires requires(EntityType& e, U&& v) { e = std::forward<U>(v); }
+        decltype(auto) operator=(U&& value)
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+        template <typename Func>
+        requires std::invocable<Func&, EntityType&>
+        void modify(Func&& func)
+        {
+            journal::record_write(entity_);
+            func(entity_);
+        }
+
+    private:
+        [[nodiscard]] const EntityType& get() const noexcept { return entity_; }
+        template <impl::not_base_of_property U>
+        void set(U&& value)
+        {
+            journal::record_write(entity_);
+            entity_ = std::forward<U>(value);
+        }
+    };
+}  // namespace cpp_property
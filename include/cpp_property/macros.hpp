@@ -0,0 +1,44 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+
+// friendly macros (included by cpp_property.hpp; include it directly after `import cpp_property;`)
+#ifndef DISABLE_CPP_PROPERTY_FRIENDLY_MACRO
+#define import_cpp_property()                                                                                          \
+    using cpp_property::property, cpp_property::auto_property, cpp_property::indexed_property,                         \
+        cpp_property::inline_property, cpp_property::static_property, cpp_property::virtual_property,                  \
+        cpp_property::get_only, cpp_property::set_only, cpp_property::modifiable, cpp_property::get_auto,              \
+        cpp_property::set_auto, cpp_property::get, cpp_property::set
+#define get_val [this]()->auto
+#define get_cref [this]()->const auto&
+#define get_ref [this]()->auto&
+#define set_val [this](auto value)->void
+#define set_cref [this](const auto& value)->void
+#define set_ref [this](auto& value)->void
+#define modify_ref [this](auto mutate)->void
+#define get_self_val [](const auto& self)->auto
+#define get_self_cref [](const auto& self)->const auto&
+#define get_self_ref [](auto& self)->auto&
+#define set_self_val [](auto& self, auto value)->void
+#define set_self_cref [](auto& self, const auto& value)->void
+#define static_get_val []()->auto
+#define static_get_cref []()->const auto&
+#define static_set_val [](auto value)->void
+#define static_set_cref [](const auto& value)->void
+#define virtual_get(NAME) [](const auto& self)->decltype(auto) { return self.NAME(); }
+#define virtual_set(NAME) [](auto& self, auto&& value)->void { self.NAME(static_cast<decltype(value)&&>(value)); }
+#else
+#define import_cpp_property()                                                                                          \
+    using cpp_property::property, cpp_property::auto_property, cpp_property::indexed_property,                         \
+        cpp_property::inline_property, cpp_property::static_property, cpp_property::virtual_property,                  \
+        cpp_property::get_only, cpp_property::set_only, cpp_property::modifiable, cpp_property::get_auto,              \
+        cpp_property::set_auto
+#endif
@@ -0,0 +1,138 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    // trivially copyable Layout kept in a memory-mapped file behind a versioned header;
+    // writes reach the file without serialization, flush() makes them durable
+    // (expose the fields as auto_property<T&> bound to storage->field)
+    template <typename Layout, std::uint32_t Version = 1>
+    requires std::is_trivially_copyable_v<Layout> && std::is_default_constructible_v<Layout>
+    class mapped_storage
+    {
+        struct header
+        {
+            std::uint64_t magic;
+            std::uint32_t version;
+            std::uint32_t offset;
+            std::uint64_t size;
+        };
+
+        static constexpr std::uint64_t magic = 0x7070'726f'705f'6d6d;
+        static constexpr std::size_t offset =
+            (sizeof(header) + alignof(Layout) - 1) / alignof(Layout) * alignof(Layout);
+        static constexpr std::size_t length = offset + sizeof(Layout);
+
+        void* base_ = nullptr;
+        bool recovered_ = false;
+
+        [[noreturn]] static void throw_errno(const char* what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+        [[nodiscard]] header* head() const noexcept { return static_cast<header*>(base_); }
+
+    public:
+        // map the file, creating it with a value-initialized Layout if it is new or empty;
+        // throws std::system_error on OS failures and std::runtime_error on a header mismatch
+        explicit mapped_storage(const std::filesystem::path& path)
+        {
+            const auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);  // NOLINT
+            if (fd < 0) throw_errno("cpp_property::mapped_storage: open");
+
+            struct stat st = {};
+            if (::fstat(fd, &st) != 0 || (st.st_size == 0 && ::ftruncate(fd, length) != 0))
+            {
+                const auto error = errno;
+                ::close(fd);
+                errno = error;
+                throw_errno("cpp_property::mapped_storage: resize");
+            }
+            if (st.st_size != 0 && static_cast<std::size_t>(st.st_size) != length)
+            {
+                ::close(fd);
+                throw std::runtime_error("cpp_property::mapped_storage: layout size mismatch");
+            }
+            base_ = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (base_ == MAP_FAILED)  // NOLINT
+            {
+                base_ = nullptr;
+                throw_errno("cpp_property::mapped_storage: mmap");
+            }
+
+            // a zero header is a file that was never initialized (or was cut off before its header was written)
+            if (head()->magic == 0)
+            {
+                ::new (static_cast<std::byte*>(base_) + offset) Layout();
+                *head() = {magic, Version, offset, sizeof(Layout)};
+                return;
+            }
+            if (head()->magic != magic || head()->version != Version || head()->offset != offset ||
+                head()->size != sizeof(Layout))
+            {
+                ::munmap(base_, length);
+                base_ = nullptr;
+                throw std::runtime_error("cpp_property::mapped_storage: incompatible layout header");
+            }
+            recovered_ = true;
+        }
+        mapped_storage(const mapped_storage&) = delete;
+        mapped_storage(mapped_storage&& other) noexcept
+            : base_(std::exchange(other.base_, nullptr)), recovered_(other.recovered_)
+        {
+        }
+        mapped_storage& operator=(const mapped_storage&) = delete;
+        mapped_storage& operator=(mapped_storage&& right) noexcept
+        {
+            std::swap(base_, right.base_);
+            std::swap(recovered_, right.recovered_);
+            return *this;
+        }
+        ~mapped_storage()
+        {
+            if (base_ != nullptr) ::munmap(base_, length);
+        }
+
+        // true if the state was loaded from an existing file
+        [[nodiscard]] bool recovered() const noexcept { return recovered_; }
+        [[nodiscard]] static constexpr std::uint32_t version() noexcept { return Version; }
+
+        [[nodiscard]] Layout& data() const noexcept
+        {
+            return *std::launder(reinterpret_cast<Layout*>(static_cast<std::byte*>(base_) + offset));
+        }
+        Layout* operator->() const noexcept { return &data(); }
+        Layout& operator*() const noexcept { return data(); }
+
+        // write barrier: returns once all previous writes are on the storage device (no-op if moved from)
+        void flush() const
+        {
+            if (base_ == nullptr) return;
+            if (::msync(base_, length, MS_SYNC) != 0) throw_errno("cpp_property::mapped_storage: msync");
+        }
+    };
+}  // namespace cpp_property
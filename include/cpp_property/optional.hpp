@@ -0,0 +1,297 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    // quiet NaN encodes "unset" of floating-point values
+    struct nan_sentinel
+    {
+        template <std::floating_point T>
+        [[nodiscard]] static constexpr T empty() noexcept
+        {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        template <std::floating_point T>
+        [[nodiscard]] static bool is_empty(const T& value) noexcept
+        {
+            return std::isnan(value);
+        }
+    };
+
+    // the given value (e.g. -1 or nullptr) encodes "unset"
+    template <auto Value>
+    struct sentinel
+    {
+        template <typename T>
+        [[nodiscard]] static constexpr T empty() noexcept
+        {
+            return static_cast<T>(Value);
+        }
+        template <typename T>
+        [[nodiscard]] static constexpr bool is_empty(const T& value) noexcept
+        {
+            return value == static_cast<T>(Value);
+        }
+    };
+
+    template <typename Sentinel, typename T>
+    concept sentinel_for = requires(const T& v) {
+        { Sentinel::template empty<T>() } -> std::same_as<T>;
+        { Sentinel::is_empty(v) } -> std::same_as<bool>;
+    };
+
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            template <typename T>
+            struct default_sentinel
+            {
+                using type = void;
+            };
+            template <std::floating_point T>
+            struct default_sentinel<T>
+            {
+                using type = nan_sentinel;
+            };
+            template <typename T>
+            requires std::is_pointer_v<T>
+            struct default_sentinel<T>
+            {
+                using type = sentinel<nullptr>;
+            };
+
+            template <typename U, typename T>
+            concept optional_ordered_with = not_base_of_property<U> &&
+                                            (!std::same_as<std::remove_cvref_t<U>, std::nullopt_t>) &&
+                                            std::three_way_comparable_with<const T&, const std::remove_cvref_t<U>&>;
+        }  // namespace detail
+    }  // namespace
+
+    // optional value without an engaged flag: a sentinel value of T encodes "unset"
+    // (assigning the sentinel value itself resets the property)
+    template <typename EntityType, typename Sentinel = typename impl::default_sentinel<EntityType>::type>
+    requires (!std::is_reference_v<EntityType>) && sentinel_for<Sentinel, EntityType>
+    class optional_property
+        : public impl::property_base<optional_property<EntityType, Sentinel>, const EntityType&, EntityType>,
+          public impl::mutable_operators<optional_property<EntityType, Sentinel>>
+    {
+        using Base = impl::property_base<optional_property<EntityType, Sentinel>, const EntityType&, EntityType>;
+        friend Base;
+
+        EntityType entity_ = Sentinel::template empty<EntityType>();
+
+    public:
+        optional_property() = default;
+        optional_property(std::nullopt_t) noexcept {}  // NOLINT
+        template <typename V>
+        requires std::constructible_from<EntityType, V&&> &&
+                 (!std::same_as<std::remove_cvref_t<V>, optional_property>) &&
+                 (!std::same_as<std::remove_cvref_t<V>, std::nullopt_t>)
+        explicit optional_property(V&& init) : entity_(std::forward<V>(init))
+        {
+        }
+        optional_property(const optional_property& other) : Base(), entity_(other.entity_) {}
+        optional_property(optional_property&& other) noexcept : Base(), entity_(std::move(other.entity_)) {}
+        ~optional_property() = default;
+
+        // copy assign operator
+        optional_property& operator=(const optional_property& right)
+        {
+            entity_ = right.entity_;
+            return *this;
+        }
+        optional_property& operator=(optional_property&& right) noexcept
+        {
+            entity_ = std::move(right.entity_);
+            return *this;
+        }
+
+        // assign operator
+        optional_property& operator=(std::nullopt_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+        template <impl::base_of_property PropertyType>
+        requires requires(EntityType& e, const PropertyType p) { e = p(); }
+        decltype(auto) operator=(const PropertyType& prop)
+        {
+            return Base::operator=(prop());
+        };
+        template <impl::not_base_of_property U>
+        requires requires(EntityType& e, U&& v) { e = std::forward<U>(v); }
+        decltype(auto) operator=(U&& value)
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+        [[nodiscard]] bool has_value() const noexcept { return !Sentinel::is_empty(entity_); }
+        template <typename U>
+        requires std::convertible_to<U&&, EntityType>
+        [[nodiscard]] EntityType value_or(U&& default_value) const
+        {
+            return has_value() ? entity_ : static_cast<EntityType>(std::forward<U>(default_value));
+        }
+        void reset() noexcept { entity_ = Sentinel::template empty<EntityType>(); }
+        [[nodiscard]] std::optional<EntityType> to_optional() const
+        {
+            return has_value() ? std::optional<EntityType>(entity_) : std::nullopt;
+        }
+
+        // comparisons like those of std::optional, which do not read an unset value: an unset property equals
+        // std::nullopt and another unset property, and differs from every value
+        friend bool operator==(const optional_property& l, std::nullopt_t) noexcept { return !l.has_value(); }
+        friend bool operator==(const optional_property& l, const optional_property& r)
+        {
+            if (!l.has_value() || !r.has_value()) return l.has_value() == r.has_value();
+            return std::equal_to<>()(l.entity_, r.entity_);
+        }
+        friend bool operator!=(const optional_property& l, const optional_property& r) { return !(l == r); }
+        template <impl::not_base_of_property U>
+        requires (!std::same_as<std::remove_cvref_t<U>, std::nullopt_t>) &&
+                 std::equality_comparable_with<const EntityType&, const std::remove_cvref_t<U>&>
+        friend bool operator==(const optional_property& l, U&& r)
+        {
+            return l.has_value() && std::equal_to<>()(l.entity_, r);
+        }
+        template <impl::not_base_of_property U>
+        requires (!std::same_as<std::remove_cvref_t<U>, std::nullopt_t>) &&
+                 std::equality_comparable_with<const EntityType&, const std::remove_cvref_t<U>&>
+        friend bool operator==(U&& l, const optional_property& r)
+        {
+            return r == l;
+        }
+        template <impl::not_base_of_property U>
+        requires (!std::same_as<std::remove_cvref_t<U>, std::nullopt_t>) &&
+                 std::equality_comparable_with<const EntityType&, const std::remove_cvref_t<U>&>
+        friend bool operator!=(const optional_property& l, U&& r)
+        {
+            return !(l == r);
+        }
+        template <impl::not_base_of_property U>
+        requires (!std::same_as<std::remove_cvref_t<U>, std::nullopt_t>) &&
+                 std::equality_comparable_with<const EntityType&, const std::remove_cvref_t<U>&>
+        friend bool operator!=(U&& l, const optional_property& r)
+        {
+            return !(r == l);
+        }
+
+        // orderings like those of std::optional: an unset property orders before every value and other properties
+        friend std::strong_ordering operator<=>(const optional_property& l, std::nullopt_t) noexcept
+        {
+            return l.has_value() <=> false;
+        }
+        friend std::compare_three_way_result_t<EntityType> operator<=>(const optional_property& l,
+                                                                       const optional_property& r)
+        requires std::three_way_comparable<EntityType>
+        {
+            if (!l.has_value() || !r.has_value()) return l.has_value() <=> r.has_value();
+            return std::compare_three_way()(l.entity_, r.entity_);
+        }
+        friend bool operator<(const optional_property& l, const optional_property& r)
+        requires std::three_way_comparable<EntityType>
+        {
+            return (l <=> r) < 0;
+        }
+        friend bool operator>(const optional_property& l, const optional_property& r)
+        requires std::three_way_comparable<EntityType>
+        {
+            return (l <=> r) > 0;
+        }
+        friend bool operator<=(const optional_property& l, const optional_property& r)
+        requires std::three_way_comparable<EntityType>
+        {
+            return (l <=> r) <= 0;
+        }
+        friend bool operator>=(const optional_property& l, const optional_property& r)
+        requires std::three_way_comparable<EntityType>
+        {
+            return (l <=> r) >= 0;
+        }
+        template <impl::optional_ordered_with<EntityType> U>
+        friend std::compare_three_way_result_t<EntityType, std::remove_cvref_t<U>> operator<=>(
+            const optional_property& l, U&& r)
+        {
+            if (!l.has_value()) return std::strong_ordering::less;
+            return std::compare_three_way()(l.entity_, r);
+        }
+        template <impl::optional_ordered_with<EntityType> U>
+        friend std::compare_three_way_result_t<EntityType, std::remove_cvref_t<U>> operator<=>(
+            U&& l, const optional_property& r)
+        {
+            return 0 <=> (r <=> l);
+        }
+        template <impl::optional_ordered_with<EntityType> U>
+        friend bool operator<(const optional_property& l, U&& r)
+        {
+            return (l <=> r) < 0;
+        }
+        template <impl::optional_ordered_with<EntityType> U>
+        friend bool operator>(const optional_property& l, U&& r)
+        {
+            return (l <=> r) > 0;
+        }
+        template <impl::optional_ordered_with<EntityType> U>
+        friend bool operator<=(const optional_property& l, U&& r)
+        {
+            return (l <=> r) <= 0;
+        }
+        template <impl::optional_ordered_with<EntityType> U>
+        friend bool operator>=(const optional_property& l, U&& r)
+        {
+            return (l <=> r) >= 0;
+        }
+        template <impl::optional_ordered_with<EntityType> U>
+        friend bool operator<(U&& l, const optional_property& r)
+        {
+            return (r <=> l) > 0;
+        }
+        template <impl::optional_ordered_with<EntityType> U>
+        friend bool operator>(U&& l, const optional_property& r)
+        {
+            return (r <=> l) < 0;
+        }
+        template <impl::optional_ordered_with<EntityType> U>
+        friend bool operator<=(U&& l, const optional_property& r)
+        {
+            return (r <=> l) >= 0;
+        }
+        template <impl::optional_ordered_with<EntityType> U>
+        friend bool operator>=(U&& l, const optional_property& r)
+        {
+            return (r <=> l) <= 0;
+        }
+
+    private:
+        // like std::optional::value(), reading an unset property throws
+        [[nodiscard]] const EntityType& get() const
+        {
+            if (!has_value()) throw std::bad_optional_access();
+            return entity_;
+        }
+        template <impl::not_base_of_property U>
+        void set(U&& value)
+        {
+            entity_ = std::forward<U>(value);
+        }
+    };
+}  // namespace cpp_property
@@ -0,0 +1,289 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            // intrusive multi-producer single-consumer queue (D. Vyukov): push is one exchange, pop is wait-free
+            // except while a producer is between its exchange and its link
+            template <typename Node>
+            class mpsc_queue
+            {
+                std::atomic<Node*> head_;
+                Node* tail_;
+                Node stub_;
+
+            public:
+                mpsc_queue() noexcept : head_(&stub_), tail_(&stub_) {}
+                mpsc_queue(const mpsc_queue&) = delete;
+                mpsc_queue(mpsc_queue&&) = delete;
+                mpsc_queue& operator=(const mpsc_queue&) = delete;
+                mpsc_queue& operator=(mpsc_queue&&) = delete;
+                ~mpsc_queue() = default;
+
+                void push(Node* node) noexcept
+                {
+                    node->next.store(nullptr, std::memory_order_relaxed);
+                    auto* prev = head_.exchange(node, std::memory_order_acq_rel);
+                    prev->next.store(node, std::memory_order_release);
+                }
+
+                // consumer only; nullptr if empty (or the next node is not linked yet)
+                [[nodiscard]] Node* pop() noexcept
+                {
+                    auto* tail = tail_;
+                    auto* next = tail->next.load(std::memory_order_acquire);
+                    if (tail == &stub_)
+                    {
+                        if (next == nullptr) return nullptr;
+                        tail_ = next;
+                        tail = next;
+                        next = next->next.load(std::memory_order_acquire);
+                    }
+                    if (next != nullptr)
+                    {
+                        tail_ = next;
+                        return tail;
+                    }
+                    if (tail != head_.load(std::memory_order_acquire)) return nullptr;
+                    push(&stub_);
+                    next = tail->next.load(std::memory_order_acquire);
+                    if (next == nullptr) return nullptr;
+                    tail_ = next;
+                    return tail;
+                }
+            };
+
+            template <typename T>
+            struct owned_write
+            {
+                std::atomic<owned_write*> next = nullptr;
+
+                owned_write() = default;
+                owned_write(const owned_write&) = delete;
+                owned_write(owned_write&&) = delete;
+                owned_write& operator=(const owned_write&) = delete;
+                owned_write& operator=(owned_write&&) = delete;
+                virtual ~owned_write() = default;
+                virtual void apply(T&) {}
+            };
+            template <typename T>
+            struct owned_assign final : owned_write<T>
+            {
+                T value;
+                template <typename U>
+                explicit owned_assign(U&& v) : value(std::forward<U>(v))
+                {
+                }
+                void apply(T& target) override { target = std::move(value); }
+            };
+            template <typename T, typename Func>
+            struct owned_modify final : owned_write<T>
+            {
+                Func func;
+                template <typename F>
+                explicit owned_modify(F&& f) : func(std::forward<F>(f))
+                {
+                }
+                void apply(T& target) override { func(target); }
+            };
+        }  // namespace detail
+    }  // namespace
+
+    // property owned by one thread: the owner reads and writes the value directly, other threads enqueue
+    // their writes on a lock-free queue which the owner applies in order by drain()
+    // (reading is only allowed on the owner thread, which is asserted in debug builds)
+    template <typename EntityType>
+    requires (!std::is_reference_v<EntityType>) && std::movable<EntityType>
+    class owned_property : public impl::property_base<owned_property<EntityType>, const EntityType&, EntityType>
+    {
+        using Base = impl::property_base<owned_property<EntityType>, const EntityType&, EntityType>;
+        friend Base;
+
+        EntityType entity_ = {};
+        std::thread::id owner_ = std::this_thread::get_id();
+        impl::mpsc_queue<impl::owned_write<EntityType>> queue_;
+
+    public:
+        owned_property() = default;
+        template <typename V>
+        requires std::constructible_from<EntityType, V&&> &&
+                 (!std::same_as<std::remove_cvref_t<V>, owned_property>)
+        explicit owned_property(V&& init) : entity_(std::forward<V>(init))
+        {
+        }
+        owned_property(const owned_property&) = delete;
+        owned_property(owned_property&&) = delete;
+        owned_property& operator=(const owned_property&) = delete;
+        owned_property& operator=(owned_property&&) = delete;
+        ~owned_property()
+        {
+            while (auto* w = queue_.pop()) delete w;
+        }
+
+        // assign operator
+        template <impl::base_of_property PropertyType>
+        requires requires(EntityType& e, const PropertyType p) { e = p(); }
+        decltype(auto) operator=(const PropertyType& prop)
+        {
+            return Base::operator=(prop());
+        };
+        template <impl::not_base_of_property U>
+        requires requires(EntityType& e, U&& v) { e = std::forward<U>(v); }
+        decltype(auto) operator=(U&& value)
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+        [[nodiscard]] bool on_owner_thread() const noexcept { return std::this_thread::get_id() == owner_; }
+        [[nodiscard]] std::thread::id owner() const noexcept { return owner_; }
+        // hand the property over to another thread (drain() first; no thread may use it meanwhile)
+        void set_owner(std::thread::id id = std::this_thread::get_id()) noexcept { owner_ = id; }
+
+        // mutate the value in place on the owner thread, or enqueue the mutation from another thread
+        template <typename Func>
+        requires std::invocable<std::remove_cvref_t<Func>&, EntityType&>
+        void modify(Func&& func)
+        {
+            if (on_owner_thread())
+                func(entity_);
+            else
+                queue_.push(
+                    new impl::owned_modify<EntityType, std::remove_cvref_t<Func>>(std::forward<Func>(func)));
+        }
+
+#pragma region read-modify-write operators
+        // applied through modify, so other threads enqueue them instead of reading the value; they return
+        // nothing because the result is not known until the owner drains the queue
+        void operator++()
+        requires requires(EntityType& e) { ++e; }
+        {
+            modify([](EntityType& e) { ++e; });
+        }
+        void operator--()
+        requires requires(EntityType& e) { --e; }
+        {
+            modify([](EntityType& e) { --e; });
+        }
+        void operator++(int)
+        requires requires(EntityType& e) { ++e; }
+        {
+            ++*this;
+        }
+        void operator--(int)
+        requires requires(EntityType& e) { --e; }
+        {
+            --*this;
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e *= r; }
+        void operator*=(U&& right)
+        {
+            modify([r = std::forward<U>(right)](EntityType& e) { e *= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e /= r; }
+        void operator/=(U&& right)
+        {
+            modify([r = std::forward<U>(right)](EntityType& e) { e /= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e %= r; }
+        void operator%=(U&& right)
+        {
+            modify([r = std::forward<U>(right)](EntityType& e) { e %= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e += r; }
+        void operator+=(U&& right)
+        {
+            modify([r = std::forward<U>(right)](EntityType& e) { e += r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e -= r; }
+        void operator-=(U&& right)
+        {
+            modify([r = std::forward<U>(right)](EntityType& e) { e -= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e <<= r; }
+        void operator<<=(U&& right)
+        {
+            modify([r = std::forward<U>(right)](EntityType& e) { e <<= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e >>= r; }
+        void operator>>=(U&& right)
+        {
+            modify([r = std::forward<U>(right)](EntityType& e) { e >>= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e &= r; }
+        void operator&=(U&& right)
+        {
+            modify([r = std::forward<U>(right)](EntityType& e) { e &= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e |= r; }
+        void operator|=(U&& right)
+        {
+            modify([r = std::forward<U>(right)](EntityType& e) { e |= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e ^= r; }
+        void operator^=(U&& right)
+        {
+            modify([r = std::forward<U>(right)](EntityType& e) { e ^= r; });
+        }
+#pragma endregion
+
+        // owner thread: apply the writes enqueued by other threads in their order, returns their number
+        std::size_t drain()
+        {
+            assert(on_owner_thread());
+            auto count = std::size_t{0};
+            while (auto* w = queue_.pop())
+            {
+                w->apply(entity_);
+                delete w;
+                ++count;
+            }
+            return count;
+        }
+
+    private:
+        [[nodiscard]] const EntityType& get() const noexcept
+        {
+            assert(on_owner_thread());
+            return entity_;
+        }
+        template <impl::not_base_of_property U>
+        void set(U&& value)
+        {
+            if (on_owner_thread())
+                entity_ = std::forward<U>(value);
+            else
+                queue_.push(new impl::owned_assign<EntityType>(std::forward<U>(value)));
+        }
+    };
+}  // namespace cpp_property
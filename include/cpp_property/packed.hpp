@@ -0,0 +1,208 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <array>
+#include <cassert>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            template <typename T>
+            concept packable = std::integral<T> || std::is_enum_v<T>;
+
+            template <packable T>
+            struct packed_integer
+            {
+                using type = T;
+            };
+            template <packable T>
+            requires std::is_enum_v<T>
+            struct packed_integer<T>
+            {
+                using type = std::underlying_type_t<T>;
+            };
+        }  // namespace detail
+    }  // namespace
+
+    // view of bits [Offset, Offset + Width) of the word of a packed_word as a bool, enum or small integer
+    // (read-only if Word is const); obtained from packed_word::field and valid while the packed_word lives
+    template <impl::packable T, std::size_t Offset, std::size_t Width, std::unsigned_integral Word>
+    requires (Width > 0) && (Offset + Width <= std::numeric_limits<Word>::digits) && (Width <= sizeof(T) * CHAR_BIT)
+    class packed_property
+        : public impl::property_base<packed_property<T, Offset, Width, Word>, T,
+                                     std::conditional_t<std::is_const_v<Word>, void, T>>
+    {
+        using Base = impl::property_base<packed_property<T, Offset, Width, Word>, T,
+                                         std::conditional_t<std::is_const_v<Word>, void, T>>;
+        friend Base;
+
+        using Bits = std::remove_const_t<Word>;
+        using Integer = typename impl::packed_integer<T>::type;
+        static constexpr auto mask = static_cast<Bits>(
+            Width == std::numeric_limits<Bits>::digits ? ~Bits{0} : (Bits{1} << Width) - 1);
+
+        Word& word_;
+
+    public:
+        static constexpr std::size_t offset = Offset;
+        static constexpr std::size_t width = Width;
+
+        // whether the field can hold the value; others are stored as their low Width bits
+        [[nodiscard]] static constexpr bool fits(T value) noexcept
+        {
+            const auto integer = static_cast<Integer>(value);
+            if constexpr (Width >= sizeof(Integer) * CHAR_BIT)
+                return true;
+            else if constexpr (std::is_signed_v<Integer>)
+                return -(std::intmax_t{1} << (Width - 1)) <= integer && integer < (std::intmax_t{1} << (Width - 1));
+            else
+                return static_cast<std::uintmax_t>(integer) < (std::uintmax_t{1} << Width);
+        }
+
+        constexpr explicit packed_property(Word& word) noexcept : word_(word) {}
+
+        // assign operator
+        template <impl::base_of_property PropertyType>
+        requires (!std::is_const_v<Word>) && std::convertible_to<decltype(std::declval<const PropertyType&>()()), T>
+        constexpr decltype(auto) operator=(const PropertyType& prop) const
+        {
+            return Base::operator=(prop());
+        };
+        template <impl::not_base_of_property U>
+        requires (!std::is_const_v<Word>) && std::convertible_to<U&&, T>
+        constexpr decltype(auto) operator=(U&& value) const
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+    private:
+        [[nodiscard]] constexpr T get() const noexcept
+        {
+            const auto bits = static_cast<Bits>((word_ >> Offset) & mask);
+            if constexpr (std::is_signed_v<Integer> && Width < sizeof(Integer) * CHAR_BIT)
+            {
+                // sign extension
+                const auto sign = static_cast<Bits>(Bits{1} << (Width - 1));
+                return static_cast<T>(static_cast<Integer>(static_cast<std::make_signed_t<Bits>>(bits ^ sign) -
+                                                           static_cast<std::make_signed_t<Bits>>(sign)));
+            }
+            else
+            {
+                return static_cast<T>(static_cast<Integer>(bits));
+            }
+        }
+        template <typename U>
+        requires (!std::is_const_v<Word>) && std::convertible_to<U&&, T>
+        constexpr void set(U&& value) const noexcept
+        {
+            const auto converted = static_cast<T>(std::forward<U>(value));
+            assert(fits(converted) && "value out of the range of the packed field");
+            const auto bits = static_cast<Bits>(static_cast<Integer>(converted));
+            word_ = static_cast<Bits>((word_ & ~static_cast<Bits>(mask << Offset)) | ((bits & mask) << Offset));
+        }
+    };
+
+    template <impl::packable T, std::size_t Width = std::same_as<T, bool> ? 1 : sizeof(T) * CHAR_BIT>
+    struct packed_field
+    {
+        using type = T;
+        static constexpr std::size_t width = Width;
+    };
+
+    template <std::unsigned_integral Word, typename... Fields>
+    class packed_word;
+
+    // assigns consecutive bits of Word to the fields at compile time
+    template <std::unsigned_integral Word, typename... Fields>
+    class packed_layout
+    {
+        static constexpr std::array<std::size_t, sizeof...(Fields)> widths = {Fields::width...};
+
+        static constexpr std::size_t offset_of(std::size_t i) noexcept
+        {
+            auto sum = std::size_t{0};
+            for (std::size_t j = 0; j < i; ++j) sum += widths[j];
+            return sum;
+        }
+
+    public:
+        static constexpr std::size_t bits = offset_of(sizeof...(Fields));
+        static_assert(bits <= std::numeric_limits<Word>::digits, "fields do not fit in the word");
+
+        using word = packed_word<Word, Fields...>;
+        template <std::size_t I, typename W = Word>
+        requires (I < sizeof...(Fields))
+        using field = packed_property<typename std::tuple_element_t<I, std::tuple<Fields...>>::type, offset_of(I),
+                                      widths[I], W>;
+    };
+
+    // owner of the backing word of packed fields: a property of the whole word for bulk reads and writes, and
+    // field<I>() returns a view of the I-th field of Layout
+    template <std::unsigned_integral Word, typename... Fields>
+    class packed_word : public impl::property_base<packed_word<Word, Fields...>, Word, Word>
+    {
+        using Base = impl::property_base<packed_word<Word, Fields...>, Word, Word>;
+        friend Base;
+
+        using Layout = packed_layout<Word, Fields...>;
+
+        Word word_ = 0;
+
+    public:
+        constexpr packed_word() noexcept = default;
+        constexpr explicit packed_word(Word word) noexcept : word_(word) {}
+
+        // assign operator
+        template <impl::base_of_property PropertyType>
+        requires std::convertible_to<decltype(std::declval<const PropertyType&>()()), Word>
+        constexpr decltype(auto) operator=(const PropertyType& prop)
+        {
+            return Base::operator=(prop());
+        };
+        template <impl::not_base_of_property U>
+        requires std::convertible_to<U&&, Word>
+        constexpr decltype(auto) operator=(U&& value)
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+        template <std::size_t I>
+        [[nodiscard]] constexpr auto field() noexcept
+        {
+            return typename Layout::template field<I>(word_);
+        }
+        template <std::size_t I>
+        [[nodiscard]] constexpr auto field() const noexcept
+        {
+            return typename Layout::template field<I, const Word>(word_);
+        }
+
+    private:
+        [[nodiscard]] constexpr Word get() const noexcept { return word_; }
+        template <typename U>
+        constexpr void set(U&& value) noexcept
+        {
+            word_ = static_cast<Word>(std::forward<U>(value));
+        }
+    };
+}  // namespace cpp_property
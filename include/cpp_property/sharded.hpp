@@ -0,0 +1,137 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    inline constexpr std::size_t cache_line_size = 64;
+
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            template <typename T>
+            struct alignas(cache_line_size) padded_slot
+            {
+                std::atomic<T> value = T{};
+            };
+
+            // threads are assigned to shards round-robin
+            inline std::size_t thread_shard_index() noexcept
+            {
+                static auto next = std::atomic<std::size_t>(0);
+                thread_local const auto index = next.fetch_add(1, std::memory_order_relaxed);
+                return index;
+            }
+        }  // namespace detail
+    }  // namespace
+
+    // counter which spreads increments over cache-line-padded slots and combines them on read
+    // (each shard takes a cache line: 1 KiB per property with the default of 16 shards)
+    template <typename EntityType, std::size_t Shards = 16>
+    requires std::is_arithmetic_v<EntityType> && (!std::same_as<EntityType, bool>) && (Shards > 0)
+    class sharded_property
+        : public impl::property_base<sharded_property<EntityType, Shards>, EntityType, EntityType>
+    {
+        using Base = impl::property_base<sharded_property<EntityType, Shards>, EntityType, EntityType>;
+        friend Base;
+
+        std::array<impl::padded_slot<EntityType>, Shards> slots_;
+
+        [[nodiscard]] std::atomic<EntityType>& local_slot() noexcept
+        {
+            return slots_[impl::thread_shard_index() % Shards].value;
+        }
+
+    public:
+        sharded_property() = default;
+        explicit sharded_property(EntityType init) noexcept { slots_[0].value.store(init, std::memory_order_relaxed); }
+
+        // assign operator (resets the counter; not linearizable with concurrent increments)
+        template <impl::base_of_property PropertyType>
+        requires std::convertible_to<decltype(std::declval<const PropertyType&>()()), EntityType>
+        decltype(auto) operator=(const PropertyType& prop)
+        {
+            return Base::operator=(prop());
+        };
+        template <impl::not_base_of_property U>
+        requires std::convertible_to<U&&, EntityType>
+        decltype(auto) operator=(U&& value)
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+#pragma region sharded compound operators
+        // the prefix forms and +=/-= only touch the slot of the calling thread; the postfix forms also read the total
+        sharded_property& operator+=(EntityType right) noexcept
+        {
+            local_slot().fetch_add(right, std::memory_order_relaxed);
+            return *this;
+        }
+        sharded_property& operator-=(EntityType right) noexcept
+        {
+            local_slot().fetch_sub(right, std::memory_order_relaxed);
+            return *this;
+        }
+        sharded_property& operator++() noexcept { return operator+=(1); }
+        sharded_property& operator--() noexcept { return operator-=(1); }
+        EntityType operator++(int) noexcept
+        {
+            const auto prev = get();
+            operator+=(1);
+            return prev;
+        }
+        EntityType operator--(int) noexcept
+        {
+            const auto prev = get();
+            operator-=(1);
+            return prev;
+        }
+
+        // the other compound operators can't be split over the slots; write counter = counter() op x instead
+        template <typename U>
+        void operator*=(const U&) = delete;
+        template <typename U>
+        void operator/=(const U&) = delete;
+        template <typename U>
+        void operator%=(const U&) = delete;
+        template <typename U>
+        void operator<<=(const U&) = delete;
+        template <typename U>
+        void operator>>=(const U&) = delete;
+        template <typename U>
+        void operator&=(const U&) = delete;
+        template <typename U>
+        void operator|=(const U&) = delete;
+        template <typename U>
+        void operator^=(const U&) = delete;
+#pragma endregion
+
+    private:
+        [[nodiscard]] EntityType get() const noexcept
+        {
+            auto sum = EntityType{};
+            for (const auto& slot : slots_) sum += slot.value.load(std::memory_order_relaxed);
+            return sum;
+        }
+        void set(EntityType value) noexcept
+        {
+            slots_[0].value.store(value, std::memory_order_relaxed);
+            for (std::size_t i = 1; i < Shards; ++i) slots_[i].value.store(EntityType{}, std::memory_order_relaxed);
+        }
+    };
+}  // namespace cpp_property
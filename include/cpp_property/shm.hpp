@@ -0,0 +1,469 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    template <typename T>
+    concept shm_storable = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>;
+
+    // value shared between processes; guarded by a sequence lock unless std::atomic<T> is lock-free
+    // (readers never block writers, writers serialize on the sequence number)
+    template <shm_storable T>
+    class shm_cell
+    {
+        // the value is copied word by word with relaxed atomics, so a reader racing with a writer may see a torn
+        // copy, which the sequence check discards, but never races on plain memory
+        using word = std::uintptr_t;
+        static constexpr std::size_t word_count = (sizeof(T) + sizeof(word) - 1) / sizeof(word);
+
+        std::atomic<std::uint32_t> sequence_ = 0;
+        std::atomic<word> words_[word_count];
+
+        [[nodiscard]] T read() const noexcept
+        {
+            word copy[word_count];
+            for (std::size_t i = 0; i < word_count; ++i) copy[i] = words_[i].load(std::memory_order_relaxed);
+            auto value = T();
+            std::memcpy(&value, copy, sizeof(T));
+            return value;
+        }
+        void write(const T& value) noexcept
+        {
+            word copy[word_count] = {};
+            std::memcpy(copy, &value, sizeof(T));
+            for (std::size_t i = 0; i < word_count; ++i) words_[i].store(copy[i], std::memory_order_relaxed);
+        }
+
+        // an odd sequence number which does not change for stale_lock_timeout belongs to a writer that died
+        // while holding the lock (e.g. a killed process); the value may be torn, so waiting is given up
+        static void check_writer(std::uint32_t s, std::uint32_t& seen, std::chrono::steady_clock::time_point& since)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (s != seen)
+            {
+                seen = s;
+                since = now;
+            }
+            else if (now - since > stale_lock_timeout)
+            {
+                throw std::runtime_error("cpp_property::shm_cell: a writer died while holding the lock");
+            }
+        }
+
+        std::uint32_t lock()
+        {
+            auto seen = std::uint32_t{0};
+            auto since = std::chrono::steady_clock::time_point();
+            for (;;)
+            {
+                auto s = sequence_.load(std::memory_order_relaxed);
+                if ((s & 1U) != 0)
+                {
+                    check_writer(s, seen, since);
+                }
+                else if (sequence_.compare_exchange_weak(s, s + 1, std::memory_order_acquire,
+                                                         std::memory_order_relaxed))
+                {
+                    std::atomic_thread_fence(std::memory_order_release);
+                    return s;
+                }
+                std::this_thread::yield();
+            }
+        }
+        void unlock(std::uint32_t s) noexcept { sequence_.store(s + 2, std::memory_order_release); }
+
+    public:
+        static constexpr bool lock_free = false;
+        static constexpr auto stale_lock_timeout = std::chrono::seconds(1);
+
+        shm_cell() noexcept { write(T()); }
+        shm_cell(const shm_cell&) = delete;
+        shm_cell(shm_cell&&) = delete;
+        shm_cell& operator=(const shm_cell&) = delete;
+        shm_cell& operator=(shm_cell&&) = delete;
+        ~shm_cell() = default;
+
+        // throws std::runtime_error if a writer died while holding the lock
+        [[nodiscard]] T load() const
+        {
+            auto seen = std::uint32_t{0};
+            auto since = std::chrono::steady_clock::time_point();
+            for (;;)
+            {
+                const auto s = sequence_.load(std::memory_order_acquire);
+                if ((s & 1U) == 0)
+                {
+                    const auto value = read();
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (sequence_.load(std::memory_order_relaxed) == s) return value;
+                }
+                else
+                {
+                    check_writer(s, seen, since);
+                }
+                std::this_thread::yield();
+            }
+        }
+        void store(const T& value)
+        {
+            const auto s = lock();
+            write(value);
+            unlock(s);
+        }
+        // read-modify-write as one update (the value is unchanged if func throws)
+        template <typename Func>
+        requires std::invocable<Func&, T&>
+        void update(Func&& func)
+        {
+            const auto s = lock();
+            auto value = read();
+            try
+            {
+                func(value);
+            }
+            catch (...)
+            {
+                unlock(s);
+                throw;
+            }
+            write(value);
+            unlock(s);
+        }
+    };
+    template <shm_storable T>
+    requires std::atomic<T>::is_always_lock_free
+    class shm_cell<T>
+    {
+        std::atomic<T> value_ = T();
+
+    public:
+        static constexpr bool lock_free = true;
+
+        [[nodiscard]] T load() const noexcept { return value_.load(std::memory_order_acquire); }
+        void store(const T& value) noexcept { value_.store(value, std::memory_order_release); }
+        template <typename Func>
+        requires std::invocable<Func&, T&>
+        void update(Func&& func)
+        {
+            auto expected = load();
+            auto desired = expected;
+            do
+            {
+                desired = expected;
+                func(desired);
+            } while (!value_.compare_exchange_weak(expected, desired, std::memory_order_acq_rel,
+                                                   std::memory_order_acquire));
+        }
+    };
+
+    // named POSIX shared-memory segment holding a Layout of shm_cell fields;
+    // the first process constructs the Layout and the others wait until it is ready (or the timeout expires
+    // if the creator died before initializing it)
+    template <typename Layout>
+    requires std::is_default_constructible_v<Layout> && std::is_standard_layout_v<Layout>
+    class shm_segment
+    {
+        struct header
+        {
+            std::atomic<std::uint32_t> ready;
+            std::uint32_t offset;
+            std::uint64_t size;
+        };
+
+        static constexpr std::size_t offset =
+            (sizeof(header) + alignof(Layout) - 1) / alignof(Layout) * alignof(Layout);
+        static constexpr std::size_t length = offset + sizeof(Layout);
+
+        void* base_ = nullptr;
+        bool created_ = false;
+
+        [[noreturn]] static void throw_errno(const char* what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+        [[nodiscard]] header* head() const noexcept { return std::launder(static_cast<header*>(base_)); }
+
+        void map(int fd)
+        {
+            base_ = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (base_ == MAP_FAILED)  // NOLINT
+            {
+                base_ = nullptr;
+                throw_errno("cpp_property::shm_segment: mmap");
+            }
+        }
+
+    public:
+        // open the segment, creating it if it does not exist; name is a POSIX shm name such as "/status"
+        // throws std::system_error on OS failures and std::runtime_error on a layout mismatch or if the segment
+        // is not initialized within timeout
+        explicit shm_segment(const std::string& name, std::chrono::milliseconds timeout = std::chrono::seconds(5))
+        {
+            if (const auto fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600); fd >= 0)  // NOLINT
+            {
+                if (::ftruncate(fd, length) != 0)
+                {
+                    const auto error = errno;
+                    ::close(fd);
+                    errno = error;
+                    throw_errno("cpp_property::shm_segment: resize");
+                }
+                map(fd);
+                created_ = true;
+                auto* h = ::new (base_) header{{0}, offset, sizeof(Layout)};
+                ::new (static_cast<std::byte*>(base_) + offset) Layout();
+                h->ready.store(1, std::memory_order_release);
+                return;
+            }
+            if (errno != EEXIST) throw_errno("cpp_property::shm_segment: shm_open");
+
+            const auto fd = ::shm_open(name.c_str(), O_RDWR, 0);  // NOLINT
+            if (fd < 0) throw_errno("cpp_property::shm_segment: shm_open");
+            // the creator may not have resized the segment yet
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            struct stat st = {};
+            while (::fstat(fd, &st) == 0 && st.st_size == 0)
+            {
+                if (std::chrono::steady_clock::now() > deadline)
+                {
+                    ::close(fd);
+                    throw std::runtime_error("cpp_property::shm_segment: the segment was not initialized in time");
+                }
+                std::this_thread::yield();
+            }
+            if (static_cast<std::size_t>(st.st_size) != length)
+            {
+                ::close(fd);
+                throw std::runtime_error("cpp_property::shm_segment: layout size mismatch");
+            }
+            map(fd);
+            while (head()->ready.load(std::memory_order_acquire) == 0)
+            {
+                if (std::chrono::steady_clock::now() > deadline)
+                {
+                    ::munmap(base_, length);
+                    base_ = nullptr;
+                    throw std::runtime_error("cpp_property::shm_segment: the segment was not initialized in time");
+                }
+                std::this_thread::yield();
+            }
+            if (head()->offset != offset || head()->size != sizeof(Layout))
+            {
+                ::munmap(base_, length);
+                base_ = nullptr;
+                throw std::runtime_error("cpp_property::shm_segment: incompatible layout");
+            }
+        }
+        shm_segment(const shm_segment&) = delete;
+        shm_segment(shm_segment&& other) noexcept
+            : base_(std::exchange(other.base_, nullptr)), created_(other.created_)
+        {
+        }
+        shm_segment& operator=(const shm_segment&) = delete;
+        shm_segment& operator=(shm_segment&& right) noexcept
+        {
+            std::swap(base_, right.base_);
+            std::swap(created_, right.created_);
+            return *this;
+        }
+        ~shm_segment()
+        {
+            if (base_ != nullptr) ::munmap(base_, length);
+        }
+
+        // remove the name; mapped segments stay valid until every process unmaps them
+        static void remove(const std::string& name) noexcept { ::shm_unlink(name.c_str()); }
+
+        // true if this process created and initialized the segment
+        [[nodiscard]] bool created() const noexcept { return created_; }
+
+        [[nodiscard]] Layout& data() const noexcept
+        {
+            return *std::launder(reinterpret_cast<Layout*>(static_cast<std::byte*>(base_) + offset));
+        }
+        Layout* operator->() const noexcept { return &data(); }
+        Layout& operator*() const noexcept { return data(); }
+    };
+
+    // property bound to an shm_cell in a shared-memory segment
+    template <typename EntityType>
+    class shm_property : public impl::property_base<shm_property<EntityType>, EntityType, EntityType>
+    {
+        using Base = impl::property_base<shm_property<EntityType>, EntityType, EntityType>;
+        friend Base;
+
+        shm_cell<EntityType>* cell_;
+
+    public:
+        explicit shm_property(shm_cell<EntityType>& cell) noexcept : cell_(&cell) {}
+        shm_property(const shm_property& other) noexcept : Base(), cell_(other.cell_) {}
+        shm_property(shm_property&& other) noexcept : Base(), cell_(other.cell_) {}
+        ~shm_property() = default;
+
+        // copy assign operator (copies the value)
+        shm_property& operator=(const shm_property& right)
+        {
+            set(right.get());
+            return *this;
+        }
+        shm_property& operator=(shm_property&& right) { return *this = std::as_const(right); }
+
+        // assign operator
+        template <impl::base_of_property PropertyType>
+        requires std::convertible_to<decltype(std::declval<const PropertyType&>()()), EntityType>
+        decltype(auto) operator=(const PropertyType& prop)
+        {
+            return Base::operator=(prop());
+        };
+        template <impl::not_base_of_property U>
+        requires std::convertible_to<U&&, EntityType>
+        decltype(auto) operator=(U&& value)
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+        // atomic read-modify-write across processes
+        template <typename Func>
+        requires std::invocable<Func&, EntityType&>
+        void modify(Func&& func)
+        {
+            cell_->update(func);
+        }
+
+#pragma region read-modify-write operators
+        // applied through modify, so each is one atomic update across processes; they return the updated
+        // value (the previous one for postfix forms) instead of reading the cell again
+        EntityType operator++()
+        requires requires(EntityType& e) { ++e; }
+        {
+            return update([](EntityType& e) { ++e; });
+        }
+        EntityType operator--()
+        requires requires(EntityType& e) { --e; }
+        {
+            return update([](EntityType& e) { --e; });
+        }
+        EntityType operator++(int)
+        requires requires(EntityType& e) { e++; }
+        {
+            auto prev = EntityType();
+            modify([&prev](EntityType& e) { prev = e++; });
+            return prev;
+        }
+        EntityType operator--(int)
+        requires requires(EntityType& e) { e--; }
+        {
+            auto prev = EntityType();
+            modify([&prev](EntityType& e) { prev = e--; });
+            return prev;
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e *= r; }
+        EntityType operator*=(U&& right)
+        {
+            return update([r = std::forward<U>(right)](EntityType& e) { e *= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e /= r; }
+        EntityType operator/=(U&& right)
+        {
+            return update([r = std::forward<U>(right)](EntityType& e) { e /= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e %= r; }
+        EntityType operator%=(U&& right)
+        {
+            return update([r = std::forward<U>(right)](EntityType& e) { e %= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e += r; }
+        EntityType operator+=(U&& right)
+        {
+            return update([r = std::forward<U>(right)](EntityType& e) { e += r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e -= r; }
+        EntityType operator-=(U&& right)
+        {
+            return update([r = std::forward<U>(right)](EntityType& e) { e -= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e <<= r; }
+        EntityType operator<<=(U&& right)
+        {
+            return update([r = std::forward<U>(right)](EntityType& e) { e <<= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e >>= r; }
+        EntityType operator>>=(U&& right)
+        {
+            return update([r = std::forward<U>(right)](EntityType& e) { e >>= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e &= r; }
+        EntityType operator&=(U&& right)
+        {
+            return update([r = std::forward<U>(right)](EntityType& e) { e &= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e |= r; }
+        EntityType operator|=(U&& right)
+        {
+            return update([r = std::forward<U>(right)](EntityType& e) { e |= r; });
+        }
+        template <typename U>
+        requires requires(EntityType& e, const std::remove_cvref_t<U>& r) { e ^= r; }
+        EntityType operator^=(U&& right)
+        {
+            return update([r = std::forward<U>(right)](EntityType& e) { e ^= r; });
+        }
+#pragma endregion
+
+    private:
+        template <typename Func>
+        EntityType update(Func&& func)
+        {
+            auto result = EntityType();
+            modify([&func, &result](EntityType& e) {
+                func(e);
+                result = e;
+            });
+            return result;
+        }
+        [[nodiscard]] EntityType get() const { return cell_->load(); }
+        template <typename U>
+        void set(U&& value)
+        {
+            cell_->store(static_cast<EntityType>(std::forward<U>(value)));
+        }
+    };
+}  // namespace cpp_property
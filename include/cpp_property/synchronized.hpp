@@ -0,0 +1,401 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    // four-byte reader/writer spin lock which prefers waiting writers
+    class shared_spin_mutex
+    {
+        static constexpr std::uint32_t writer = 1;
+        static constexpr std::uint32_t writer_pending = 2;
+        static constexpr std::uint32_t reader = 4;
+        static constexpr auto spin_count = 64;
+
+        std::atomic<std::uint32_t> state_ = 0;
+
+    public:
+        shared_spin_mutex() = default;
+        shared_spin_mutex(const shared_spin_mutex&) = delete;
+        shared_spin_mutex(shared_spin_mutex&&) = delete;
+        shared_spin_mutex& operator=(const shared_spin_mutex&) = delete;
+        shared_spin_mutex& operator=(shared_spin_mutex&&) = delete;
+        ~shared_spin_mutex() = default;
+
+        bool try_lock() noexcept
+        {
+            auto s = state_.load(std::memory_order_relaxed);
+            return (s & ~writer_pending) == 0 &&
+                   state_.compare_exchange_strong(s, writer, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+        void lock() noexcept
+        {
+            for (auto i = 0;; ++i)
+            {
+                auto s = state_.load(std::memory_order_relaxed);
+                if ((s & ~writer_pending) == 0)
+                {
+                    if (state_.compare_exchange_weak(s, writer, std::memory_order_acquire, std::memory_order_relaxed))
+                        return;
+                    continue;
+                }
+                if ((s & writer_pending) == 0) state_.fetch_or(writer_pending, std::memory_order_relaxed);
+                if (i >= spin_count) std::this_thread::yield();
+            }
+        }
+        void unlock() noexcept { state_.fetch_and(~writer, std::memory_order_release); }
+
+        bool try_lock_shared() noexcept
+        {
+            auto s = state_.load(std::memory_order_relaxed);
+            return (s & (writer | writer_pending)) == 0 &&
+                   state_.compare_exchange_strong(s, s + reader, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+        void lock_shared() noexcept
+        {
+            for (auto i = 0;; ++i)
+            {
+                auto s = state_.load(std::memory_order_relaxed);
+                if ((s & (writer | writer_pending)) == 0)
+                {
+                    if (state_.compare_exchange_weak(s, s + reader, std::memory_order_acquire,
+                                                     std::memory_order_relaxed))
+                        return;
+                    continue;
+                }
+                if (i >= spin_count) std::this_thread::yield();
+            }
+        }
+        void unlock_shared() noexcept { state_.fetch_sub(reader, std::memory_order_release); }
+    };
+
+    template <typename Mutex>
+    concept shared_lockable = requires(Mutex& m) {
+        m.lock();
+        m.unlock();
+        m.lock_shared();
+        m.unlock_shared();
+    };
+
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            template <typename Mutex>
+            class mutex_holder
+            {
+                Mutex mutex_;
+
+            public:
+                mutex_holder() = default;
+                Mutex& get() noexcept { return mutex_; }
+            };
+            template <typename Mutex>
+            class mutex_holder<Mutex&>
+            {
+                Mutex* mutex_;
+
+            public:
+                explicit mutex_holder(Mutex& m) noexcept : mutex_(&m) {}
+                Mutex& get() const noexcept { return *mutex_; }
+            };
+
+            template <typename Mutex>
+            class exclusive_guard
+            {
+                Mutex& mutex_;
+
+            public:
+                explicit exclusive_guard(Mutex& m) : mutex_(m) { mutex_.lock(); }
+                exclusive_guard(const exclusive_guard&) = delete;
+                exclusive_guard(exclusive_guard&&) = delete;
+                exclusive_guard& operator=(const exclusive_guard&) = delete;
+                exclusive_guard& operator=(exclusive_guard&&) = delete;
+                ~exclusive_guard() { mutex_.unlock(); }
+            };
+            template <typename Mutex>
+            class shared_guard
+            {
+                Mutex& mutex_;
+
+            public:
+                explicit shared_guard(Mutex& m) : mutex_(m) { mutex_.lock_shared(); }
+                shared_guard(const shared_guard&) = delete;
+                shared_guard(shared_guard&&) = delete;
+                shared_guard& operator=(const shared_guard&) = delete;
+                shared_guard& operator=(shared_guard&&) = delete;
+                ~shared_guard() { mutex_.unlock_shared(); }
+            };
+
+            struct synchronized_access;
+        }  // namespace detail
+    }  // namespace
+
+    // property with a backing field guarded by a reader/writer lock
+    // (Mutex may be an lvalue reference to share one lock between properties)
+    template <typename EntityType, typename Mutex = shared_spin_mutex>
+    requires (!std::is_reference_v<EntityType>) && shared_lockable<std::remove_reference_t<Mutex>>
+    class synchronized_property
+        : public impl::property_base<synchronized_property<EntityType, Mutex>, EntityType, EntityType>
+    {
+        using Base = impl::property_base<synchronized_property<EntityType, Mutex>, EntityType, EntityType>;
+        friend Base;
+        friend struct impl::synchronized_access;
+
+        using MutexType = std::remove_reference_t<Mutex>;
+        EntityType entity_ = {};
+        mutable impl::mutex_holder<Mutex> mutex_;
+
+        template <typename Func>
+        decltype(auto) exclusive(Func&& func)
+        {
+            const auto lock = impl::exclusive_guard<MutexType>(mutex_.get());
+            return std::invoke(std::forward<Func>(func), entity_);
+        }
+
+    public:
+        synchronized_property()
+        requires (!std::is_reference_v<Mutex>)
+        = default;
+        template <typename V>
+        requires (!std::is_reference_v<Mutex>) && std::constructible_from<EntityType, V&&>
+        explicit synchronized_property(V&& init) : entity_(std::forward<V>(init))
+        {
+        }
+        explicit synchronized_property(MutexType& mutex)
+        requires std::is_reference_v<Mutex>
+            : mutex_(mutex)
+        {
+        }
+        template <typename V>
+        requires std::is_reference_v<Mutex> && std::constructible_from<EntityType, V&&>
+        synchronized_property(MutexType& mutex, V&& init) : entity_(std::forward<V>(init)), mutex_(mutex)
+        {
+        }
+
+        [[nodiscard]] MutexType& mutex() const noexcept { return mutex_.get(); }
+
+        // assign operator
+        template <impl::base_of_property PropertyType>
+        requires requires(EntityType& e, const PropertyType p) { e = p(); }
+        decltype(auto) operator=(const PropertyType& prop)
+        {
+            return Base::operator=(prop());
+        };
+        template <impl::not_base_of_property U>
+        requires requires(EntityType& e, U&& v) { e = std::forward<U>(v); }
+        decltype(auto) operator=(U&& value)
+        {
+            return Base::operator=(std::forward<U>(value));
+        };
+
+        // read-modify-write under one exclusive acquisition
+        template <typename Func>
+        requires std::invocable<Func&&, EntityType&>
+        decltype(auto) modify(Func&& func)
+        {
+            return exclusive(std::forward<Func>(func));
+        }
+        // inspect the backing field under a shared lock without copying it
+        template <typename Func>
+        requires std::invocable<Func&&, const EntityType&>
+        decltype(auto) read(Func&& func) const
+        {
+            const auto lock = impl::shared_guard<MutexType>(mutex_.get());
+            return std::invoke(std::forward<Func>(func), std::as_const(entity_));
+        }
+
+#pragma region atomic compound operators
+        auto operator++(int)
+        requires requires(EntityType v) { v + 1; }
+        {
+            return exclusive([](EntityType& e) {
+                auto prev = e;
+                e = e + 1;
+                return prev;
+            });
+        }
+        auto operator--(int)
+        requires requires(EntityType v) { v - 1; }
+        {
+            return exclusive([](EntityType& e) {
+                auto prev = e;
+                e = e - 1;
+                return prev;
+            });
+        }
+        auto operator++()
+        requires requires(EntityType v) { v + 1; }
+        {
+            return exclusive([](EntityType& e) { return e = e + 1; });
+        }
+        auto operator--()
+        requires requires(EntityType v) { v - 1; }
+        {
+            return exclusive([](EntityType& e) { return e = e - 1; });
+        }
+
+        template <typename U>
+        requires requires(EntityType v, const U& r) { v * r; }
+        auto operator*=(const U& right)
+        {
+            return exclusive([&right](EntityType& e) { return e = e * right; });
+        }
+        template <typename U>
+        requires requires(EntityType v, const U& r) { v / r; }
+        auto operator/=(const U& right)
+        {
+            return exclusive([&right](EntityType& e) { return e = e / right; });
+        }
+        template <typename U>
+        requires requires(EntityType v, const U& r) { v % r; }
+        auto operator%=(const U& right)
+        {
+            return exclusive([&right](EntityType& e) { return e = e % right; });
+        }
+        template <typename U>
+        requires requires(EntityType v, const U& r) { v + r; }
+        auto operator+=(const U& right)
+        {
+            return exclusive([&right](EntityType& e) { return e = e + right; });
+        }
+        template <typename U>
+        requires requires(EntityType v, const U& r) { v - r; }
+        auto operator-=(const U& right)
+        {
+            return exclusive([&right](EntityType& e) { return e = e - right; });
+        }
+        template <typename U>
+        requires requires(EntityType v, const U& r) { v << r; }
+        auto operator<<=(const U& right)
+        {
+            return exclusive([&right](EntityType& e) { return e = e << right; });
+        }
+        template <typename U>
+        requires requires(EntityType v, const U& r) { v >> r; }
+        auto operator>>=(const U& right)
+        {
+            return exclusive([&right](EntityType& e) { return e = e >> right; });
+        }
+        template <typename U>
+        requires requires(EntityType v, const U& r) { v & r; }
+        auto operator&=(const U& right)
+        {
+            return exclusive([&right](EntityType& e) { return e = e & right; });
+        }
+        template <typename U>
+        requires requires(EntityType v, const U& r) { v | r; }
+        auto operator|=(const U& right)
+        {
+            return exclusive([&right](EntityType& e) { return e = e | right; });
+        }
+        template <typename U>
+        requires requires(EntityType v, const U& r) { v ^ r; }
+        auto operator^=(const U& right)
+        {
+            return exclusive([&right](EntityType& e) { return e = e ^ right; });
+        }
+#pragma endregion
+
+    private:
+        [[nodiscard]] EntityType get() const
+        {
+            const auto lock = impl::shared_guard<MutexType>(mutex_.get());
+            return entity_;
+        }
+        template <impl::not_base_of_property U>
+        void set(U&& value)
+        {
+            const auto lock = impl::exclusive_guard<MutexType>(mutex_.get());
+            entity_ = std::forward<U>(value);
+        }
+    };
+
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            struct synchronized_access
+            {
+                template <typename EntityType, typename Mutex>
+                static auto& mutex(const synchronized_property<EntityType, Mutex>& p) noexcept
+                {
+                    return p.mutex_.get();
+                }
+                template <typename EntityType, typename Mutex>
+                static const EntityType& entity(const synchronized_property<EntityType, Mutex>& p) noexcept
+                {
+                    return p.entity_;
+                }
+            };
+
+            template <typename>
+            struct is_synchronized_property : std::false_type
+            {
+            };
+            template <typename EntityType, typename Mutex>
+            struct is_synchronized_property<synchronized_property<EntityType, Mutex>> : std::true_type
+            {
+            };
+
+            template <typename Mutex, std::size_t N>
+            class shared_guards
+            {
+                std::array<Mutex*, N> mutexes_;
+                Mutex** end_;
+
+            public:
+                explicit shared_guards(const std::array<Mutex*, N>& mutexes) : mutexes_(mutexes)
+                {
+                    // lock each distinct mutex once, in address order
+                    std::sort(mutexes_.begin(), mutexes_.end(), std::less<>());
+                    end_ = std::unique(mutexes_.begin(), mutexes_.end());
+                    for (auto it = mutexes_.begin(); it != end_; ++it) (*it)->lock_shared();
+                }
+                shared_guards(const shared_guards&) = delete;
+                shared_guards(shared_guards&&) = delete;
+                shared_guards& operator=(const shared_guards&) = delete;
+                shared_guards& operator=(shared_guards&&) = delete;
+                ~shared_guards()
+                {
+                    for (auto it = mutexes_.begin(); it != end_; ++it) (*it)->unlock_shared();
+                }
+            };
+        }  // namespace detail
+    }  // namespace
+
+    // consistent snapshot of several synchronized properties
+    // (properties sharing a mutex are read under a single acquisition)
+    template <typename Property, typename... Properties>
+    requires impl::is_synchronized_property<Property>::value &&
+             (impl::is_synchronized_property<Properties>::value && ...) &&
+             (std::same_as<decltype(impl::synchronized_access::mutex(std::declval<const Property&>())),
+                           decltype(impl::synchronized_access::mutex(std::declval<const Properties&>()))> &&
+              ...)
+    auto synchronized_read(const Property& prop, const Properties&... props)
+    {
+        using MutexType = std::remove_reference_t<decltype(impl::synchronized_access::mutex(prop))>;
+        const auto lock = impl::shared_guards<MutexType, 1 + sizeof...(Properties)>(
+            {&impl::synchronized_access::mutex(prop), &impl::synchronized_access::mutex(props)...});
+        return std::tuple(impl::synchronized_access::entity(prop), impl::synchronized_access::entity(props)...);
+    }
+}  // namespace cpp_property
@@ -0,0 +1,281 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../cpp_property.hpp"
+
+#ifndef CPP_PROPERTY_TELEMETRY_RING_SIZE
+#define CPP_PROPERTY_TELEMETRY_RING_SIZE 4096
+#endif
+
+// rings are reused by later threads; threads beyond this many concurrent recorders drop their samples
+#ifndef CPP_PROPERTY_TELEMETRY_MAX_RINGS
+#define CPP_PROPERTY_TELEMETRY_MAX_RINGS 64
+#endif
+
+// timestamp source of samples (e.g. define as __rdtsc() where the clock read dominates the write path)
+#ifndef CPP_PROPERTY_TELEMETRY_NOW
+#define CPP_PROPERTY_TELEMETRY_NOW()                                                                              \
+    static_cast<std::uint64_t>(                                                                                   \
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()) \
+            .count())
+#endif
+
+namespace cpp_property
+{
+    class telemetry_channel;
+
+    struct telemetry_sample
+    {
+        std::uint64_t timestamp;  // steady_clock nanoseconds by default
+        const telemetry_channel* channel;
+        double value;
+    };
+
+    // single-producer single-consumer ring of one thread; a ring released by an exiting thread is adopted by the
+    // next thread that records, and all rings are freed at static destruction (threads must stop recording before)
+    class telemetry_ring
+    {
+    public:
+        static constexpr std::size_t capacity = CPP_PROPERTY_TELEMETRY_RING_SIZE;
+        static_assert((capacity & (capacity - 1)) == 0, "ring size must be a power of two");
+        static constexpr std::size_t max_rings = CPP_PROPERTY_TELEMETRY_MAX_RINGS;
+
+    private:
+        alignas(64) std::atomic<std::uint64_t> tail_ = 0;  // producer side
+        std::uint64_t cached_head_ = 0;
+        std::atomic<std::uint64_t> dropped_ = 0;
+        alignas(64) std::atomic<std::uint64_t> head_ = 0;  // consumer side
+        std::atomic<bool> owned_ = true;
+        telemetry_ring* next_ = nullptr;
+        std::array<telemetry_sample, capacity> slots_ = {};
+
+        // lock-free list of all rings, owned until static destruction
+        struct ring_list
+        {
+            std::atomic<telemetry_ring*> head = nullptr;
+            std::atomic<std::size_t> size = 0;
+            std::atomic<std::uint64_t> dropped = 0;  // samples of threads without a ring
+
+            ring_list() = default;
+            ring_list(const ring_list&) = delete;
+            ring_list(ring_list&&) = delete;
+            ring_list& operator=(const ring_list&) = delete;
+            ring_list& operator=(ring_list&&) = delete;
+            ~ring_list()
+            {
+                for (auto* ring = head.load(std::memory_order_acquire); ring != nullptr;)
+                    delete std::exchange(ring, ring->next_);  // NOLINT
+            }
+        };
+        static ring_list& rings() noexcept
+        {
+            static auto list = ring_list();
+            return list;
+        }
+        // adopt a released ring or allocate a new one; nullptr if max_rings are in use
+        static telemetry_ring* acquire()
+        {
+            auto& list = rings();
+            for (auto* ring = list.head.load(std::memory_order_acquire); ring != nullptr; ring = ring->next_)
+            {
+                auto owned = false;
+                if (ring->owned_.compare_exchange_strong(owned, true, std::memory_order_acquire)) return ring;
+            }
+            if (list.size.fetch_add(1, std::memory_order_relaxed) >= max_rings)
+            {
+                list.size.fetch_sub(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            auto* ring = new telemetry_ring();  // NOLINT
+            ring->next_ = list.head.load(std::memory_order_relaxed);
+            while (!list.head.compare_exchange_weak(ring->next_, ring, std::memory_order_release,
+                                                    std::memory_order_relaxed))
+            {
+            }
+            return ring;
+        }
+
+        telemetry_ring() = default;
+
+    public:
+        // serializes collectors
+        static std::mutex& drain_mutex() noexcept
+        {
+            static auto mutex = std::mutex();
+            return mutex;
+        }
+
+        telemetry_ring(const telemetry_ring&) = delete;
+        telemetry_ring(telemetry_ring&&) = delete;
+        telemetry_ring& operator=(const telemetry_ring&) = delete;
+        telemetry_ring& operator=(telemetry_ring&&) = delete;
+        ~telemetry_ring() = default;
+
+        // ring of the calling thread, nullptr if every ring is in use by other threads
+        static telemetry_ring* local()
+        {
+            struct holder
+            {
+                telemetry_ring* ring = acquire();
+                holder() = default;
+                holder(const holder&) = delete;
+                holder(holder&&) = delete;
+                holder& operator=(const holder&) = delete;
+                holder& operator=(holder&&) = delete;
+                ~holder()
+                {
+                    if (ring != nullptr) ring->owned_.store(false, std::memory_order_release);
+                }
+            };
+            thread_local auto h = holder();
+            return h.ring;
+        }
+        // count a sample of a thread without a ring
+        static void drop() noexcept { rings().dropped.fetch_add(1, std::memory_order_relaxed); }
+        [[nodiscard]] static std::uint64_t dropped_without_ring() noexcept
+        {
+            return rings().dropped.load(std::memory_order_relaxed);
+        }
+
+        // producer: drops the sample if the ring is full
+        void push(const telemetry_sample& sample) noexcept
+        {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cached_head_ == capacity)
+            {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (tail - cached_head_ == capacity) [[unlikely]]
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            slots_[tail & (capacity - 1)] = sample;
+            tail_.store(tail + 1, std::memory_order_release);
+        }
+
+        // consumer: append the pending samples to out
+        std::size_t drain(std::vector<telemetry_sample>& out)
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+            const auto tail = tail_.load(std::memory_order_acquire);
+            for (auto i = head; i != tail; ++i) out.push_back(slots_[i & (capacity - 1)]);
+            head_.store(tail, std::memory_order_release);
+            return static_cast<std::size_t>(tail - head);
+        }
+        [[nodiscard]] std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+        template <typename Func>
+        requires std::invocable<Func&, telemetry_ring&>
+        static void for_each(Func&& func)
+        {
+            for (auto* ring = rings().head.load(std::memory_order_acquire); ring != nullptr; ring = ring->next_)
+                func(*ring);
+        }
+    };
+
+    // named time series; channels must outlive the samples drained from them
+    class telemetry_channel
+    {
+        const char* name_;
+        std::atomic<bool> enabled_ = true;
+
+    public:
+        explicit telemetry_channel(const char* name) noexcept : name_(name) {}
+        telemetry_channel(const telemetry_channel&) = delete;
+        telemetry_channel(telemetry_channel&&) = delete;
+        telemetry_channel& operator=(const telemetry_channel&) = delete;
+        telemetry_channel& operator=(telemetry_channel&&) = delete;
+        ~telemetry_channel() = default;
+
+        [[nodiscard]] const char* name() const noexcept { return name_; }
+        [[nodiscard]] bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+        void enable(bool on = true) noexcept { enabled_.store(on, std::memory_order_relaxed); }
+
+        // timestamp the value into the ring of the calling thread
+        void record(double value) noexcept
+        {
+            if (!enabled()) return;
+            if (auto* ring = telemetry_ring::local(); ring != nullptr) [[likely]]
+                ring->push({CPP_PROPERTY_TELEMETRY_NOW(), this, value});
+            else
+                telemetry_ring::drop();
+        }
+    };
+
+    // collector: pass every pending sample of every thread to func, returns the number of samples
+    // (samples of one thread are in order; the rings are emptied under a lock shared by concurrent collectors,
+    // and func is called after it is released, so it may block, record or drain)
+    template <typename Func>
+    requires std::invocable<Func&, const telemetry_sample&>
+    std::size_t drain_telemetry(Func&& func)
+    {
+        auto samples = std::vector<telemetry_sample>();
+        {
+            const auto lock = std::scoped_lock(telemetry_ring::drain_mutex());
+            telemetry_ring::for_each([&](telemetry_ring& ring) { ring.drain(samples); });
+        }
+        for (const auto& sample : samples) func(sample);
+        return samples.size();
+    }
+    // samples lost because a ring was full or max_rings threads were recording
+    [[nodiscard]] inline std::uint64_t telemetry_dropped() noexcept
+    {
+        auto sum = telemetry_ring::dropped_without_ring();
+        telemetry_ring::for_each([&](const telemetry_ring& ring) { sum += ring.dropped(); });
+        return sum;
+    }
+
+    // setter wrapper which records each assigned value into a channel after the setter returns
+    template <typename Func>
+    class sampled_function
+    {
+        telemetry_channel* channel_;
+        Func func_;
+
+    public:
+        template <typename F>
+        sampled_function(telemetry_channel& channel, F&& func) : channel_(&channel), func_(std::forward<F>(func))
+        {
+        }
+
+        template <typename A>
+        requires std::invocable<const Func&, A> && std::is_arithmetic_v<std::remove_cvref_t<A>>
+        void operator()(A&& value) const
+        {
+            const auto sample = static_cast<double>(value);
+            std::invoke(func_, std::forward<A>(value));
+            channel_->record(sample);
+        }
+    };
+
+    // attach a channel to the set path of a property
+    template <typename Func>
+    auto sampled([[maybe_unused]] telemetry_channel& channel, Func&& func)
+    {
+#ifdef CPP_PROPERTY_DISABLE_TELEMETRY
+        return std::remove_cvref_t<Func>(std::forward<Func>(func));
+#else
+        return sampled_function<std::remove_cvref_t<Func>>(channel, std::forward<Func>(func));
+#endif
+    }
+}  // namespace cpp_property
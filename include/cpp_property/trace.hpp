@@ -0,0 +1,253 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../cpp_property.hpp"
+
+#ifndef CPP_PROPERTY_TRACE_SAMPLE_PERIOD
+#define CPP_PROPERTY_TRACE_SAMPLE_PERIOD 64
+#endif
+
+// USDT probe "cpp_property:accessor" with arguments (const char* name, uint64_t nanoseconds)
+#if !defined(CPP_PROPERTY_DISABLE_USDT) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define CPP_PROPERTY_TRACEPOINT(name, nanoseconds) DTRACE_PROBE2(cpp_property, accessor, name, nanoseconds)
+#else
+#define CPP_PROPERTY_TRACEPOINT(name, nanoseconds) static_cast<void>(0)
+#endif
+
+namespace cpp_property
+{
+    class latency_histogram
+    {
+    public:
+        // bucket i counts samples in [2^(i-1), 2^i) nanoseconds, bucket 0 counts zero
+        static constexpr std::size_t bucket_count = 65;
+
+    private:
+        std::array<std::atomic<std::uint64_t>, bucket_count> buckets_ = {};
+
+    public:
+        void record(std::uint64_t nanoseconds) noexcept
+        {
+            buckets_[std::bit_width(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        }
+        [[nodiscard]] std::uint64_t bucket(std::size_t i) const noexcept
+        {
+            return buckets_[i].load(std::memory_order_relaxed);
+        }
+        [[nodiscard]] static constexpr std::uint64_t upper_bound(std::size_t i) noexcept
+        {
+            return i == 0 ? 0 : i >= 64 ? UINT64_MAX : (std::uint64_t{1} << i) - 1;
+        }
+        [[nodiscard]] std::uint64_t count() const noexcept
+        {
+            auto sum = std::uint64_t{0};
+            for (const auto& b : buckets_) sum += b.load(std::memory_order_relaxed);
+            return sum;
+        }
+        // upper bound in nanoseconds of the bucket containing the q-quantile (0 <= q <= 1)
+        [[nodiscard]] std::uint64_t quantile(double q) const noexcept
+        {
+            const auto total = count();
+            if (total == 0) return 0;
+            const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total - 1));
+            auto seen = std::uint64_t{0};
+            for (std::size_t i = 0; i < bucket_count; ++i)
+            {
+                seen += bucket(i);
+                if (seen > rank) return upper_bound(i);
+            }
+            return upper_bound(bucket_count - 1);
+        }
+        void reset() noexcept
+        {
+            for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    // named accessor statistics; sites must have static storage duration and are never unregistered
+    class trace_site
+    {
+        const char* name_;
+        std::size_t id_;
+        std::atomic<std::uint32_t> period_;
+        std::atomic<std::uint64_t> max_ = 0;
+        latency_histogram histogram_;
+        trace_site* next_ = nullptr;
+
+        static std::atomic<trace_site*>& registry() noexcept
+        {
+            static auto head = std::atomic<trace_site*>(nullptr);
+            return head;
+        }
+        static std::size_t next_id() noexcept
+        {
+            static auto count = std::atomic<std::size_t>(0);
+            return count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    public:
+        explicit trace_site(const char* name, std::uint32_t period = CPP_PROPERTY_TRACE_SAMPLE_PERIOD)
+            : name_(name), id_(next_id()), period_(period)
+        {
+            auto& head = registry();
+            next_ = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(next_, this, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+        trace_site(const trace_site&) = delete;
+        trace_site(trace_site&&) = delete;
+        trace_site& operator=(const trace_site&) = delete;
+        trace_site& operator=(trace_site&&) = delete;
+        ~trace_site() = default;
+
+        [[nodiscard]] const char* name() const noexcept { return name_; }
+        [[nodiscard]] const latency_histogram& histogram() const noexcept { return histogram_; }
+        [[nodiscard]] std::uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+        // sample every n-th call per thread (0 disables sampling)
+        [[nodiscard]] std::uint32_t period() const noexcept { return period_.load(std::memory_order_relaxed); }
+        void set_period(std::uint32_t n) noexcept { period_.store(n, std::memory_order_relaxed); }
+
+        // calls of the calling thread left until the next sample or period poll of this site
+        // (the reference is invalidated when the thread first uses a site registered later)
+        [[nodiscard]] std::uint32_t& countdown() const
+        {
+            thread_local auto countdowns = std::vector<std::uint32_t>();
+            if (id_ >= countdowns.size()) [[unlikely]]
+                countdowns.resize(id_ + 1);
+            return countdowns[id_];
+        }
+
+        void record(std::uint64_t nanoseconds) noexcept
+        {
+            histogram_.record(nanoseconds);
+            auto prev = max_.load(std::memory_order_relaxed);
+            while (prev < nanoseconds &&
+                   !max_.compare_exchange_weak(prev, nanoseconds, std::memory_order_relaxed))
+            {
+            }
+            CPP_PROPERTY_TRACEPOINT(name_, nanoseconds);
+        }
+        void reset() noexcept
+        {
+            histogram_.reset();
+            max_.store(0, std::memory_order_relaxed);
+        }
+
+        template <typename Func>
+        requires std::invocable<Func&, trace_site&>
+        static void for_each(Func&& func)
+        {
+            for (auto* site = registry().load(std::memory_order_acquire); site != nullptr; site = site->next_)
+                func(*site);
+        }
+        [[nodiscard]] static trace_site* find(std::string_view name) noexcept
+        {
+            for (auto* site = registry().load(std::memory_order_acquire); site != nullptr; site = site->next_)
+                if (name == site->name_) return site;
+            return nullptr;
+        }
+        // site of the given name, registered on first use (the name must outlive the site)
+        static trace_site& named(const char* name)
+        {
+            static auto mutex = std::mutex();
+            const auto lock = std::scoped_lock(mutex);
+            if (auto* site = find(name); site != nullptr) return *site;
+            return *new trace_site(name);  // NOLINT
+        }
+    };
+
+    // accessor wrapper which samples the latency of every n-th call into a per-accessor trace_site
+    template <typename Func>
+    class traced_function
+    {
+        Func func_;
+
+        class sample_scope
+        {
+            trace_site& site_;
+            std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+        public:
+            explicit sample_scope(trace_site& site) noexcept : site_(site) {}
+            sample_scope(const sample_scope&) = delete;
+            sample_scope(sample_scope&&) = delete;
+            sample_scope& operator=(const sample_scope&) = delete;
+            sample_scope& operator=(sample_scope&&) = delete;
+            ~sample_scope()
+            {
+                const auto elapsed = std::chrono::steady_clock::now() - start_;
+                site_.record(static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            }
+        };
+
+        // calls between re-reads of the period while sampling is disabled
+        static constexpr std::uint32_t disabled_poll_interval = 1024;
+
+        trace_site* site_;
+
+    public:
+        template <typename F>
+        traced_function(const char* name, F&& func) : func_(std::forward<F>(func)), site_(&trace_site::named(name))
+        {
+        }
+
+        [[nodiscard]] trace_site& site() const noexcept { return *site_; }
+
+        template <typename... As>
+        requires std::invocable<const Func&, As...>
+        decltype(auto) operator()(As&&... args) const
+        {
+            // per thread and site; only updated before func_ runs, which may trace other sites
+            auto& countdown = site_->countdown();
+            if (countdown != 0) [[likely]]
+            {
+                --countdown;
+                return std::invoke(func_, std::forward<As>(args)...);
+            }
+            const auto period = site_->period();
+            if (period == 0)
+            {
+                countdown = disabled_poll_interval - 1;
+                return std::invoke(func_, std::forward<As>(args)...);
+            }
+            countdown = period - 1;
+            const auto scope = sample_scope(*site_);
+            return std::invoke(func_, std::forward<As>(args)...);
+        }
+    };
+
+    // wrap a getter or setter to attribute its sampled latency to the given name
+    template <typename Func>
+    auto traced([[maybe_unused]] const char* name, Func&& func)
+    {
+#ifdef CPP_PROPERTY_DISABLE_TRACE
+        return std::remove_cvref_t<Func>(std::forward<Func>(func));
+#else
+        return traced_function<std::remove_cvref_t<Func>>(name, std::forward<Func>(func));
+#endif
+    }
+}  // namespace cpp_property
@@ -0,0 +1,82 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include "../cpp_property.hpp"
+
+namespace cpp_property
+{
+    // non-owning view types which stay valid after the object they were created from is destroyed
+    template <typename View>
+    concept borrowed_view = std::ranges::view<View> && std::ranges::borrowed_range<View>;
+
+    namespace  // NOLINT
+    {
+        namespace detail
+        {
+            // a View may be formed from a getter result only if the result does not own the viewed elements,
+            // i.e. an lvalue of the backing storage or another borrowed range such as std::span
+            template <typename View, typename Result>
+            constexpr auto is_dangling_view =
+                !std::ranges::borrowed_range<Result> || !std::convertible_to<Result, View>;
+        }  // namespace detail
+    }  // namespace
+
+    // get-only property which returns a borrowed view (std::string_view, std::span, ...) of its backing field
+    template <borrowed_view View>
+    class view_property : public impl::property_base<view_property<View>, View, void>
+    {
+        using Base = impl::property_base<view_property<View>, View, void>;
+        friend Base;
+
+        const impl::small_function<View()> getter_;  // NOLINT
+
+    public:
+        view_property() = delete;
+        view_property(const view_property&) = delete;
+        view_property(view_property&&) = delete;
+        view_property& operator=(const view_property&) = delete;
+        view_property& operator=(view_property&&) = delete;
+        ~view_property() = default;
+
+        template <typename Getter>
+        requires requires(Getter&& g) {
+            impl::small_function<View()>{g};
+            requires !(impl::is_dangling_view<View, decltype(g())>);
+        }
+        view_property(Getter&& get_f) : getter_(std::forward<Getter>(get_f))  // NOLINT
+        {
+        }
+
+#pragma region range interface
+        [[nodiscard]] auto begin() const { return std::ranges::begin(get()); }
+        [[nodiscard]] auto end() const { return std::ranges::end(get()); }
+        [[nodiscard]] auto size() const
+        requires std::ranges::sized_range<View>
+        {
+            return std::ranges::size(get());
+        }
+        [[nodiscard]] bool empty() const { return std::ranges::empty(get()); }
+        [[nodiscard]] auto data() const
+        requires std::ranges::contiguous_range<View>
+        {
+            return std::ranges::data(get());
+        }
+#pragma endregion
+
+    private:
+        [[nodiscard]] View get() const { return getter_(); }
+    };
+}  // namespace cpp_property
@@ -0,0 +1,30 @@
+/*===================================================*
+|  cpp-property version v0.0.1                       |
+|  https://github.com/yosh-matsuda/cpp-property      |
+|                                                    |
+|  Copyright (c) 2023 Yoshiki Matsuda @yosh-matsuda  |
+|                                                    |
+|  This software is released under the MIT License.  |
+|  https://opensource.org/license/mit/               |
+====================================================*/
+
+// named module of the core header; importers use the friendly macros by including "cpp_property/macros.hpp"
+module;
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+#ifndef CPP_PROPERTY_MINIMAL_INCLUDE
+#include <functional>
+#endif
+
+export module cpp_property;
+
+#define CPP_PROPERTY_MODULE_INTERFACE
+export
+{
+#include "cpp_property.hpp"
+}
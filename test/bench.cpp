@@ -1,5 +1,17 @@
 #include <benchmark/benchmark.h>
+#include <atomic>
+#include <string>
+#include <vector>
 #include "cpp_property.hpp"
+#include "cpp_property/async.hpp"
+#include "cpp_property/coalesce.hpp"
+#include "cpp_property/expression.hpp"
+#include "cpp_property/interned.hpp"
+#include "cpp_property/journal.hpp"
+#include "cpp_property/owned.hpp"
+#include "cpp_property/sharded.hpp"
+#include "cpp_property/shm.hpp"
+#include "cpp_property/telemetry.hpp"
 
 import_cpp_property();
 
@@ -50,6 +62,16 @@ public:
     property<double, set_only> p_auto_set_only = set_auto { num_ };
 
     auto_property<double> ap { get, set };
+    inline_property<const double&, A, get_self_cref { return self.num_; }, set_self_val
+    {
+        self.num_ = value;
+    }> ip { this };
+
+    static inline double scale_ = 1.0;
+    static inline static_property<const double&, static_get_cref { return scale_; }, static_set_val
+    {
+        scale_ = value;
+    }> sp;
 
     [[nodiscard]] const auto& get_num() const { return num_; }
     void set_num(auto value)
@@ -86,6 +108,13 @@ void get_ap(benchmark::State& state)
         tmp = a.ap;
     }
 }
+void get_ip(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        tmp = a.ip;
+    }
+}
 void get_call(benchmark::State& state)
 {
     for (auto _ : state)
@@ -114,6 +143,14 @@ void set_ap(benchmark::State& state)
         a.ap = tmp;
     }
 }
+void set_ip(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        const auto value = tmp;
+        a.ip = value;
+    }
+}
 void set_num(benchmark::State& state)
 {
     for (auto _ : state)
@@ -150,17 +187,436 @@ void set_p_auto_set_only(benchmark::State& state)
     }
 }
 
+cpp_property::sharded_property<std::int64_t> sharded_counter;
+std::atomic<std::int64_t> atomic_counter;
+void increment_sharded(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        ++sharded_counter;
+    }
+}
+void increment_atomic(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        atomic_counter.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// GCC warns about the switch it generates for coroutine bodies
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-default"
+#endif
+// stand-in for a slow resource served on its own I/O thread
+class RemoteA
+{
+    double num_ = 0;
+
+public:
+    cpp_property::thread_executor io;
+    cpp_property::async_property<double> p_async_inline{
+        [this]() -> cpp_property::task<double> { co_return num_; },
+        [this](double value) -> cpp_property::task<void> {
+            num_ = value;
+            co_return;
+        }};
+    cpp_property::async_property<double, cpp_property::thread_executor> p_async_thread{
+        io, [this]() -> cpp_property::task<double> { co_return num_; },
+        [this](double value) -> cpp_property::task<void> {
+            num_ = value;
+            co_return;
+        }};
+};
+RemoteA remote;
+
+void get_async_inline(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        tmp = cpp_property::sync_wait(remote.p_async_inline.get_async());
+    }
+}
+void get_async_thread(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        tmp = cpp_property::sync_wait(remote.p_async_thread.get_async());
+    }
+}
+void set_async_thread(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        cpp_property::sync_wait(remote.p_async_thread.set_async(tmp));
+    }
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+class Particles
+{
+public:
+    auto_property<std::vector<double>> pos{std::vector<double>(1024, 0.0)};
+    auto_property<std::vector<double>> vel{std::vector<double>(1024, 1.0)};
+};
+Particles particles;
+
+std::vector<double> operator+(const std::vector<double>& l, const std::vector<double>& r)
+{
+    auto out = std::vector<double>(l.size());
+    for (std::size_t i = 0; i < l.size(); ++i) out[i] = l[i] + r[i];
+    return out;
+}
+std::vector<double> operator*(const std::vector<double>& l, double r)
+{
+    auto out = std::vector<double>(l.size());
+    for (std::size_t i = 0; i < l.size(); ++i) out[i] = l[i] * r;
+    return out;
+}
+
+void update_eager(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        particles.pos = particles.pos() + particles.vel() * tmp;
+        benchmark::DoNotOptimize(particles.pos().data());
+    }
+}
+void update_lazy(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        particles.pos = cpp_property::lazy(particles.pos) + cpp_property::lazy(particles.vel) * tmp;
+        benchmark::DoNotOptimize(particles.pos().data());
+    }
+}
+
+// one million objects holding one of 200 distinct category names
+constexpr auto OBJECTS = 1000000;
+constexpr auto CATEGORIES = 200;
+std::string category_name(int i) { return "category-name-" + std::to_string(i % CATEGORIES); }
+struct StringTagged
+{
+    auto_property<std::string> category;
+};
+struct InternedTagged
+{
+    cpp_property::interned_property<> category;
+};
+
+void string_memory(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto objects = std::vector<StringTagged>(OBJECTS);
+        auto bytes = std::size_t{0};
+        for (auto i = 0; i < OBJECTS; ++i)
+        {
+            objects[static_cast<std::size_t>(i)].category = category_name(i);
+            const auto& s = objects[static_cast<std::size_t>(i)].category();
+            bytes += sizeof(objects[0]) + (s.capacity() > 15 ? s.capacity() + 1 : 0);
+        }
+        state.counters["bytes_per_object"] = static_cast<double>(bytes) / OBJECTS;
+    }
+}
+void interned_memory(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto objects = std::vector<InternedTagged>(OBJECTS);
+        for (auto i = 0; i < OBJECTS; ++i) objects[static_cast<std::size_t>(i)].category = category_name(i);
+        // handles plus the shared strings of the table
+        const auto shared = static_cast<double>(cpp_property::intern_table<>::instance().size()) *
+                            static_cast<double>(sizeof(std::string) + category_name(0).size() + 1);
+        state.counters["bytes_per_object"] = static_cast<double>(sizeof(objects[0])) + shared / OBJECTS;
+    }
+}
+void string_compare(benchmark::State& state)
+{
+    auto l = StringTagged();
+    auto r = StringTagged();
+    l.category = category_name(7);
+    r.category = category_name(7);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(l.category() == r.category());
+    }
+}
+void interned_compare(benchmark::State& state)
+{
+    auto l = InternedTagged();
+    auto r = InternedTagged();
+    l.category = category_name(7);
+    r.category = category_name(7);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(l.category == r.category);
+    }
+}
+
+auto journaled = cpp_property::journaled_property<double>();
+void set_journaled_inactive(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        const auto value = tmp;
+        journaled = value;
+    }
+}
+void set_journaled_active(benchmark::State& state)
+{
+    auto history = cpp_property::journal();
+    const auto scope = cpp_property::journal::scope(history);
+    auto i = 0;
+    for (auto _ : state)
+    {
+        const auto value = tmp;
+        journaled = value;
+        // keep the history bounded; clear() only rewinds the arena
+        if (++i == 1024)
+        {
+            history.clear();
+            i = 0;
+        }
+    }
+}
+
+struct BenchExtent
+{
+    double begin;
+    double end;
+};
+struct BenchStatus
+{
+    cpp_property::shm_cell<double> load;
+    cpp_property::shm_cell<BenchExtent> extent;
+};
+void get_shm_atomic(benchmark::State& state)
+{
+    const auto name = std::string("/cpp_property_bench_atomic");
+    cpp_property::shm_segment<BenchStatus>::remove(name);
+    auto segment = cpp_property::shm_segment<BenchStatus>(name);
+    auto load = cpp_property::shm_property<double>(segment->load);
+    for (auto _ : state)
+    {
+        tmp = load;
+    }
+    cpp_property::shm_segment<BenchStatus>::remove(name);
+}
+void get_shm_seqlock(benchmark::State& state)
+{
+    const auto name = std::string("/cpp_property_bench_seqlock");
+    cpp_property::shm_segment<BenchStatus>::remove(name);
+    auto segment = cpp_property::shm_segment<BenchStatus>(name);
+    auto extent = cpp_property::shm_property<BenchExtent>(segment->extent);
+    for (auto _ : state)
+    {
+        tmp = extent().end;
+    }
+    cpp_property::shm_segment<BenchStatus>::remove(name);
+}
+
+auto bench_channel = cpp_property::telemetry_channel("bench");
+// clang-format off
+class Sampled
+{
+    double num_ = 0;
+
+public:
+    property<double> num
+    {
+        get_val { return num_; },
+        cpp_property::sampled(bench_channel, set_val { num_ = value; })
+    };
+};
+// clang-format on
+void set_sampled(benchmark::State& state)
+{
+    auto s = Sampled();
+    auto i = 0;
+    for (auto _ : state)
+    {
+        const auto value = tmp;
+        s.num = value;
+        // the collector side, off the measured path
+        if (++i == 1024)
+        {
+            state.PauseTiming();
+            cpp_property::drain_telemetry([](const cpp_property::telemetry_sample&) {});
+            state.ResumeTiming();
+            i = 0;
+        }
+    }
+}
+
+auto bench_feed = cpp_property::coalescer();
+// clang-format off
+class Coalesced
+{
+    double num_ = 0;
+
+public:
+    property<double> num
+    {
+        get_val { return num_; },
+        cpp_property::coalesced<double>(bench_feed, set_val { num_ = value; })
+    };
+};
+// clang-format on
+void set_coalesced(benchmark::State& state)
+{
+    auto c = Coalesced();
+    for (auto _ : state)
+    {
+        const auto value = tmp;
+        c.num = value;
+    }
+    bench_feed.flush();
+}
+
+void get_owned(benchmark::State& state)
+{
+    auto p = cpp_property::owned_property<double>(1.0);
+    for (auto _ : state)
+    {
+        tmp = p;
+    }
+}
+void set_owned(benchmark::State& state)
+{
+    auto p = cpp_property::owned_property<double>();
+    for (auto _ : state)
+    {
+        const auto value = tmp;
+        p = value;
+    }
+}
+class Widget
+{
+    double num_ = 0;
+
+protected:
+    [[nodiscard]] virtual const double& get_num() const { return num_; }
+    virtual void set_num(double value) { num_ = value; }
+
+public:
+    virtual_property<const double&, Widget, &Widget::get_num, &Widget::set_num> vp{this};
+
+    Widget() = default;
+    Widget(const Widget&) = delete;
+    Widget(Widget&&) = delete;
+    Widget& operator=(const Widget&) = delete;
+    Widget& operator=(Widget&&) = delete;
+    virtual ~Widget() = default;
+};
+class Label final
+{
+    double num_ = 0;
+    [[nodiscard]] virtual const double& get_num() const { return num_; }
+    virtual void set_num(double value) { num_ = value; }
+
+public:
+    virtual_property<const double&, Label, virtual_get(get_num), virtual_set(set_num)> vp{this};
+
+    Label() = default;
+    Label(const Label&) = delete;
+    Label(Label&&) = delete;
+    Label& operator=(const Label&) = delete;
+    Label& operator=(Label&&) = delete;
+    virtual ~Label() = default;
+};
+void get_virtual(benchmark::State& state)
+{
+    auto w = Widget();
+    for (auto _ : state)
+    {
+        tmp = w.vp;
+    }
+}
+void set_virtual(benchmark::State& state)
+{
+    auto w = Widget();
+    for (auto _ : state)
+    {
+        const auto value = tmp;
+        w.vp = value;
+    }
+}
+void get_virtual_final(benchmark::State& state)
+{
+    auto l = Label();
+    for (auto _ : state)
+    {
+        tmp = l.vp;
+    }
+}
+void set_virtual_final(benchmark::State& state)
+{
+    auto l = Label();
+    for (auto _ : state)
+    {
+        const auto value = tmp;
+        l.vp = value;
+    }
+}
+void get_static(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        tmp = A::sp;
+    }
+}
+void set_static(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        const auto value = tmp;
+        A::sp = value;
+    }
+}
+
 BENCHMARK(get_fn_fn);
 BENCHMARK(get_auto_fn);
 BENCHMARK(get_ap);
+BENCHMARK(get_ip);
 BENCHMARK(get_call);
 BENCHMARK(set_p_fn_fn);
 BENCHMARK(set_p_fn_auto);
 BENCHMARK(set_ap);
+BENCHMARK(set_ip);
 BENCHMARK(set_num);
 BENCHMARK(get_fn_get_only);
 BENCHMARK(get_auto_get_only);
 BENCHMARK(set_p_fn_set_only);
 BENCHMARK(set_p_auto_set_only);
+BENCHMARK(get_async_inline);
+BENCHMARK(get_async_thread);
+BENCHMARK(set_async_thread);
+BENCHMARK(increment_sharded)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(increment_atomic)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(update_eager);
+BENCHMARK(update_lazy);
+BENCHMARK(string_memory)->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK(interned_memory)->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK(string_compare);
+BENCHMARK(interned_compare);
+BENCHMARK(set_journaled_inactive);
+BENCHMARK(set_journaled_active);
+BENCHMARK(get_shm_atomic);
+BENCHMARK(get_shm_seqlock);
+BENCHMARK(set_sampled);
+BENCHMARK(set_coalesced);
+
+BENCHMARK(get_owned);
+BENCHMARK(set_owned);
+BENCHMARK(get_static);
+BENCHMARK(set_static);
+BENCHMARK(get_virtual);
+BENCHMARK(set_virtual);
+BENCHMARK(get_virtual_final);
+BENCHMARK(set_virtual_final);
 
 BENCHMARK_MAIN();
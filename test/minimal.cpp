@@ -0,0 +1,45 @@
+// cpp_property.hpp alone in minimal-include mode: the optional standard headers must stay out
+#define CPP_PROPERTY_MINIMAL_INCLUDE
+#include "cpp_property.hpp"
+
+#if defined(_GLIBCXX_FUNCTIONAL) || defined(_GLIBCXX_MEMORY)
+#error "cpp_property.hpp includes <functional> or <memory> with CPP_PROPERTY_MINIMAL_INCLUDE"
+#endif
+#if defined(_LIBCPP_FUNCTIONAL) || defined(_LIBCPP_MEMORY)
+#error "cpp_property.hpp includes <functional> or <memory> with CPP_PROPERTY_MINIMAL_INCLUDE"
+#endif
+#ifdef CPP_PROPERTY_INTERNAL_NAMESPACE
+#error "CPP_PROPERTY_INTERNAL_NAMESPACE leaks out of cpp_property.hpp"
+#endif
+
+// NOLINTBEGIN
+import_cpp_property();
+
+static_assert(std::is_base_of_v<std::exception, cpp_property::bad_accessor_call>);
+
+// clang-format off
+class Counter
+{
+    int count_ = 0;
+
+public:
+    auto_property<int> step{1};
+    property<int> count
+    {
+        get_val { return count_; },
+        set_val { count_ = value; }
+    };
+    property<int, get_only> twice = get_val { return count_ * 2; };
+};
+// clang-format on
+
+int main()
+{
+    auto c = Counter();
+    c.count = 2;
+    c.count += c.step;
+    c.step = 5;
+    c.count = c.count + c.step;
+    return c.count == 8 && c.twice == 16 ? 0 : 1;
+}
+// NOLINTEND
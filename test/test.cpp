@@ -1,5 +1,36 @@
 #include <gtest/gtest.h>
+#include <cmath>
+#include <deque>
+#include <filesystem>
+#include <latch>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 #include "cpp_property.hpp"
+#include "cpp_property/async.hpp"
+#include "cpp_property/binding.hpp"
+#include "cpp_property/coalesce.hpp"
+#include "cpp_property/cow.hpp"
+#include "cpp_property/expression.hpp"
+#include "cpp_property/interned.hpp"
+#include "cpp_property/journal.hpp"
+#if __has_include(<sys/mman.h>)
+#include <sys/wait.h>
+#include <unistd.h>
+#include "cpp_property/mapped.hpp"
+#include "cpp_property/shm.hpp"
+#endif
+#include "cpp_property/optional.hpp"
+#include "cpp_property/owned.hpp"
+#include "cpp_property/packed.hpp"
+#include "cpp_property/sharded.hpp"
+#include "cpp_property/synchronized.hpp"
+#include "cpp_property/telemetry.hpp"
+#include "cpp_property/trace.hpp"
+#include "cpp_property/view.hpp"
 
 // NOLINTBEGIN
 import_cpp_property();
@@ -201,4 +232,1613 @@ TEST(CppProperty, Operators)
     p_bits >>= 2;
     EXPECT_EQ(0b0100, bits);
 }
+
+// clang-format off
+class Traced
+{
+    double num_ = 0;
+
+public:
+    property<const double&> num
+    {
+        cpp_property::traced("Traced::num.get", get_cref
+        {
+            return num_;
+        }),
+        cpp_property::traced("Traced::num.set", set_val
+        {
+            num_ = value;
+        })
+    };
+};
+// clang-format on
+
+TEST(CppProperty, Trace)
+{
+    auto t = Traced();
+    auto* get_site = cpp_property::trace_site::find("Traced::num.get");
+    auto* set_site = cpp_property::trace_site::find("Traced::num.set");
+    ASSERT_NE(nullptr, get_site);
+    ASSERT_NE(nullptr, set_site);
+    set_site->set_period(1);
+    get_site->set_period(0);
+
+    for (auto i = 0; i < 10; ++i) t.num = i;
+    EXPECT_EQ(9.0, t.num());
+    EXPECT_EQ(10U, set_site->histogram().count());
+    EXPECT_EQ(0U, get_site->histogram().count());
+    EXPECT_GE(set_site->histogram().quantile(1.0), set_site->max());
+
+    auto names = std::vector<std::string_view>();
+    cpp_property::trace_site::for_each([&](const cpp_property::trace_site& site) { names.emplace_back(site.name()); });
+    EXPECT_NE(names.end(), std::find(names.begin(), names.end(), "Traced::num.set"));
+
+    // wrappers of the same type keep their own sites
+    constexpr auto twice = +[](int x) { return 2 * x; };
+    constexpr auto square = +[](int x) { return x * x; };
+    const auto a = cpp_property::traced("Trace.twice", twice);
+    const auto b = cpp_property::traced("Trace.square", square);
+    static_assert(std::same_as<decltype(a), decltype(b)>);
+    EXPECT_EQ("Trace.twice", std::string_view(a.site().name()));
+    EXPECT_EQ("Trace.square", std::string_view(b.site().name()));
+    EXPECT_EQ(&a.site(), &cpp_property::traced("Trace.twice", twice).site());
+    a.site().set_period(1);
+    b.site().set_period(1);
+    EXPECT_EQ(6, a(3));
+    EXPECT_EQ(9, b(3));
+    EXPECT_EQ(1U, a.site().histogram().count());
+    EXPECT_EQ(1U, b.site().histogram().count());
+
+    // and their own countdowns, so a disabled sibling doesn't delay sampling
+    a.site().reset();
+    b.site().reset();
+    a.site().set_period(2);
+    b.site().set_period(0);
+    for (auto i = 0; i < 10; ++i)
+    {
+        static_cast<void>(a(i));
+        static_cast<void>(b(i));
+    }
+    EXPECT_EQ(5U, a.site().histogram().count());
+    EXPECT_EQ(0U, b.site().histogram().count());
+
+    // a disabled site picks up a new period after a bounded number of calls
+    get_site->reset();
+    get_site->set_period(1);
+    for (auto i = 0; i < 2048; ++i) static_cast<void>(t.num());
+    EXPECT_LT(0U, get_site->histogram().count());
+}
+
+TEST(CppProperty, Synchronized)
+{
+    using cpp_property::synchronized_property, cpp_property::shared_spin_mutex;
+    constexpr auto THREADS = 4;
+    constexpr auto ITERATIONS = 10000;
+
+    auto counter = synchronized_property<std::int64_t>(0);
+    auto items = synchronized_property<std::vector<int>>();
+    {
+        auto threads = std::vector<std::jthread>();
+        for (auto t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([&] {
+                for (auto i = 0; i < ITERATIONS; ++i)
+                {
+                    counter += 2;
+                    counter--;
+                    items.modify([i](std::vector<int>& v) { v.push_back(i); });
+                }
+            });
+        }
+    }
+    EXPECT_EQ(THREADS * ITERATIONS, counter());
+    EXPECT_EQ(THREADS * ITERATIONS, items.read([](const std::vector<int>& v) { return v.size(); }));
+
+    // properties sharing one lock are read consistently
+    auto mutex = shared_spin_mutex();
+    auto x = synchronized_property<double, shared_spin_mutex&>(mutex, 1.0);
+    auto y = synchronized_property<double, shared_spin_mutex&>(mutex, 2.0);
+    const auto [vx, vy] = cpp_property::synchronized_read(x, y);
+    EXPECT_EQ(1.0, vx);
+    EXPECT_EQ(2.0, vy);
+    EXPECT_EQ(&mutex, &x.mutex());
+
+    x = 3.0;
+    EXPECT_EQ(4.0, ++x);
+    EXPECT_EQ(5.0, x + 1.0);
+}
+
+template <typename T>
+concept scalable_in_place = requires(T& t) { t *= 2; };
+
+TEST(CppProperty, Sharded)
+{
+    constexpr auto THREADS = 8;
+    constexpr auto ITERATIONS = 10000;
+
+    auto counter = cpp_property::sharded_property<std::int64_t, 4>(10);
+    static_assert(sizeof(counter) == 4 * cpp_property::cache_line_size);
+    {
+        auto threads = std::vector<std::jthread>();
+        for (auto t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([&] {
+                for (auto i = 0; i < ITERATIONS; ++i)
+                {
+                    ++counter;
+                    counter += 2;
+                    --counter;
+                }
+            });
+        }
+    }
+    EXPECT_EQ(10 + 2 * THREADS * ITERATIONS, counter());
+    EXPECT_TRUE(counter > 10);
+
+    counter = 5;
+    counter++;
+    EXPECT_EQ(6, counter());
+
+    // results of the operators are usable in expressions
+    const std::int64_t next = ++counter;
+    EXPECT_EQ(7, next);
+    EXPECT_EQ(7, counter++);
+    EXPECT_EQ(8, counter--);
+    EXPECT_EQ(12, (counter += 5)());
+    EXPECT_EQ(10, (counter -= 2) + 0);
+    static_assert(sizeof(cpp_property::sharded_property<int>) == 16 * cpp_property::cache_line_size);
+
+    // compound operators which can't be sharded are deleted
+    static_assert(!scalable_in_place<cpp_property::sharded_property<int>>);
+    static_assert(scalable_in_place<int>);
+    counter = counter() * 3;
+    EXPECT_EQ(30, counter());
+}
+
+// stand-in for a slow configuration daemon which must only be accessed from its own I/O thread
+class ConfigService
+{
+    double scale_ = 1.0;
+
+public:
+    cpp_property::thread_executor io;
+    std::thread::id last_access;
+
+    double load()
+    {
+        last_access = std::this_thread::get_id();
+        return scale_;
+    }
+    void store(double value)
+    {
+        last_access = std::this_thread::get_id();
+        if (value < 0) throw std::invalid_argument("value must be >= 0");
+        scale_ = value;
+    }
+};
+
+// GCC warns about the switch it generates for coroutine bodies
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-default"
+#endif
+class RemoteConfig
+{
+    ConfigService& service_;
+
+public:
+    explicit RemoteConfig(ConfigService& service) : service_(service) {}
+
+    cpp_property::async_property<double, cpp_property::thread_executor> scale{
+        service_.io, [this]() -> cpp_property::task<double> { co_return service_.load(); },
+        [this](double value) -> cpp_property::task<void> {
+            service_.store(value);
+            co_return;
+        }};
+};
+
+TEST(CppProperty, Async)
+{
+    using cpp_property::sync_wait, cpp_property::task;
+    auto service = ConfigService();
+    auto config = RemoteConfig(service);
+
+    EXPECT_EQ(1.0, sync_wait(config.scale.get_async()));
+    EXPECT_EQ(service.io.thread_id(), service.last_access);
+
+    auto routine = [&config]() -> task<double> {
+        co_await config.scale.set_async(2.0);
+        co_return co_await config.scale;
+    };
+    EXPECT_EQ(2.0, sync_wait(routine()));
+    EXPECT_EQ(service.io.thread_id(), service.last_access);
+    EXPECT_NE(std::this_thread::get_id(), service.last_access);
+
+    EXPECT_THROW(sync_wait(config.scale.set_async(-1.0)), std::invalid_argument);
+
+    // default executor resumes inline
+    auto value = 5;
+    auto local = cpp_property::async_property<int>([&value]() -> task<int> { co_return value; });
+    EXPECT_EQ(5, sync_wait(local.get_async()));
+    EXPECT_THROW(sync_wait(local.set_async(1)), cpp_property::bad_accessor_call);
+
+    // awaiting coroutines are resumed on their own executor, not on the I/O thread
+    auto caller = cpp_property::thread_executor();
+    auto other = cpp_property::thread_executor();
+    auto resumed = std::array<std::thread::id, 4>();
+    auto on_caller = [&]() -> task<double> {
+        co_await cpp_property::schedule_on(caller);
+        co_await (config.scale = 3.0);
+        resumed[0] = std::this_thread::get_id();
+        const auto scale = co_await config.scale;
+        resumed[1] = std::this_thread::get_id();
+        try
+        {
+            co_await config.scale.set_async(-1.0);
+        }
+        catch (const std::invalid_argument&)
+        {
+            resumed[2] = std::this_thread::get_id();
+        }
+        co_await config.scale.get_async(other);
+        resumed[3] = std::this_thread::get_id();
+        co_return scale;
+    };
+    EXPECT_EQ(3.0, sync_wait(on_caller()));
+    EXPECT_EQ(service.io.thread_id(), service.last_access);
+    EXPECT_EQ(caller.thread_id(), resumed[0]);
+    EXPECT_EQ(caller.thread_id(), resumed[1]);
+    EXPECT_EQ(caller.thread_id(), resumed[2]);
+    EXPECT_EQ(other.thread_id(), resumed[3]);
+    EXPECT_EQ(nullptr, cpp_property::thread_executor::current());
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+class Indexed
+{
+    std::vector<double> values_ = {1.0, 2.0, 3.0, 4.0};
+
+public:
+    indexed_property<const double&(std::size_t)> values{
+        [this](std::size_t i) -> const double& { return values_[i]; },
+        [this](std::size_t i, double value) {
+            if (value < 0) throw std::invalid_argument("value must be >= 0");
+            values_[i] = value;
+        }};
+    indexed_property<double(std::size_t), get_only> squares = [this](std::size_t i) {
+        return values_[i] * values_[i];
+    };
+    [[nodiscard]] const std::vector<double>& raw() const { return values_; }
+};
+
+TEST(CppProperty, Indexed)
+{
+    auto a = Indexed();
+    static_assert(std::same_as<const double&, decltype(a.values[0]())>);
+    EXPECT_EQ(&a.raw()[1], &a.values[1]());
+
+    a.values[0] = 10.0;
+    a.values[1] += 1.0;
+    a.values[2]++;
+    EXPECT_EQ(10.0, a.raw()[0]);
+    EXPECT_EQ(3.0, a.raw()[1]);
+    EXPECT_EQ(4.0, a.raw()[2]);
+    EXPECT_THROW(a.values[3] = -1.0, std::invalid_argument);
+    EXPECT_EQ(16.0, a.squares[2]());
+    static_assert(!std::is_assignable_v<decltype(a.squares[0]), double>);
+
+    auto sum = 0.0;
+    for (auto v : a.values.range(1, 4)) sum += v;
+    EXPECT_EQ(3.0 + 4.0 + 4.0, sum);
+    EXPECT_EQ(3U, a.values.range(1, 4).size());
+
+    auto out = std::vector<double>(2);
+    a.values.get_n(2, 2, out.begin());
+    EXPECT_EQ((std::vector<double>{4.0, 4.0}), out);
+    const auto in = std::array{5.0, 6.0};
+    a.values.set_n(0, in.size(), in.begin());
+    EXPECT_EQ(5.0, a.raw()[0]);
+    EXPECT_EQ(6.0, a.raw()[1]);
+
+    auto deduced = indexed_property{[&a](std::size_t i) -> const double& { return a.raw()[i]; }};
+    static_assert(std::same_as<decltype(deduced), indexed_property<const double&(std::size_t), get_only>>);
+}
+
+class Named
+{
+    std::string name_ = "cpp-property";
+    std::vector<int> data_ = {1, 2, 3};
+
+public:
+    cpp_property::view_property<std::string_view> name = [this]() -> const std::string& { return name_; };
+    cpp_property::view_property<std::span<const int>> data = [this]() -> const std::vector<int>& { return data_; };
+    cpp_property::view_property<std::span<const int>> head = [this] { return std::span<const int>(data_).first(2); };
+};
+
+TEST(CppProperty, View)
+{
+    auto a = Named();
+    EXPECT_EQ(a.name, "cpp-property");
+    EXPECT_EQ(12U, a.name.size());
+    EXPECT_EQ(a.name().data(), a.name.data());
+    EXPECT_EQ(3U, a.data.size());
+    EXPECT_EQ(2U, a.head().size());
+
+    auto sum = 0;
+    for (auto v : a.data) sum += v;
+    EXPECT_EQ(6, sum);
+    auto doubled = a.data() | std::views::transform([](int v) { return 2 * v; });
+    EXPECT_EQ(4, *std::ranges::next(doubled.begin()));
+    EXPECT_EQ('c', a.name[0]);
+
+    // views over temporaries are rejected
+    static_assert(std::constructible_from<cpp_property::view_property<std::string_view>, std::string_view (*)()>);
+    static_assert(std::constructible_from<cpp_property::view_property<std::string_view>, const std::string& (*)()>);
+    static_assert(!std::constructible_from<cpp_property::view_property<std::string_view>, std::string (*)()>);
+    static_assert(!std::constructible_from<cpp_property::view_property<std::span<const int>>, std::vector<int> (*)()>);
+    static_assert(!std::is_assignable_v<cpp_property::view_property<std::string_view>&, std::string_view>);
+}
+
+struct Counted
+{
+    static inline auto copies = 0;
+    int value = 0;
+    explicit Counted(int v) : value(v) {}
+    Counted(const Counted& other) : value(other.value) { ++copies; }
+    Counted(Counted&&) = default;
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() = default;
+    auto operator<=>(const Counted&) const = default;
+};
+
+TEST(CppProperty, CopyFreeAccess)
+{
+    auto counted = Counted(1);
+    auto other = Counted(2);
+    auto by_ref = property{[&counted]() -> const Counted& { return counted; }};
+    auto other_ref = property{[&other]() -> const Counted& { return other; }};
+    auto by_value = property{[] { return Counted(3); }};
+
+    Counted::copies = 0;
+    static_assert(std::same_as<const Counted*, decltype(by_ref.operator->())>);
+    EXPECT_EQ(1, by_ref->value);
+    EXPECT_EQ(3, by_value->value);
+    EXPECT_TRUE(by_ref < other_ref);
+    EXPECT_TRUE(by_ref == counted);
+    EXPECT_TRUE(other > by_ref);
+    EXPECT_EQ(std::strong_ordering::less, by_ref <=> other_ref);
+    EXPECT_EQ(std::strong_ordering::greater, other <=> by_ref);
+    EXPECT_EQ(std::strong_ordering::equal, by_ref <=> counted);
+    EXPECT_EQ(0, Counted::copies);
+}
+
+class Body
+{
+    std::vector<double> pos_ = {0.0, 1.0, 2.0};
+
+public:
+    property<const std::vector<double>&> pos = {[this]() -> const std::vector<double>& { return pos_; },
+                                                [this](std::vector<double> value) { pos_ = std::move(value); }};
+    auto_property<std::vector<double>> vel{std::vector<double>{1.0, 2.0, 3.0}};
+    auto_property<std::array<float, 2>> dir{std::array{1.0F, -1.0F}};
+    property<std::vector<double>, get_only> offset = [] { return std::vector<double>{10.0, 20.0, 30.0}; };
+};
+
+template <typename T>
+concept lazily_viewable = requires(T&& t) { cpp_property::lazy(std::forward<T>(t)); };
+
+TEST(CppProperty, Expression)
+{
+    using cpp_property::lazy;
+    auto a = Body();
+    const auto dt = 0.5;
+
+    auto expr = lazy(a.pos) + lazy(a.vel) * dt;
+    EXPECT_EQ(3U, expr.size());
+    EXPECT_EQ(2.0, expr[1]);
+
+    a.pos = lazy(a.pos) + lazy(a.vel) * dt;
+    EXPECT_EQ((std::vector<double>{0.5, 2.0, 3.5}), a.pos());
+    a.pos = -(lazy(a.offset) - lazy(a.pos)) / 2.0 + 1.0;
+    EXPECT_EQ((std::vector<double>{-3.75, -8.0, -12.25}), a.pos());
+
+    a.dir = 2.0F * lazy(a.dir);
+    EXPECT_EQ((std::array{2.0F, -2.0F}), a.dir());
+
+    const auto raw = std::vector<double>{1.0, 1.0, 1.0};
+    const std::vector<double> sum = lazy(raw) + lazy(a.vel);
+    EXPECT_EQ((std::vector<double>{2.0, 3.0, 4.0}), sum);
+
+    // only sequence containers are targets of the conversion
+    using Sum = decltype(lazy(raw) + lazy(a.vel));
+    static_assert(std::is_convertible_v<Sum, std::vector<double>>);
+    static_assert(std::is_convertible_v<Sum, std::deque<double>>);
+    static_assert(!std::is_convertible_v<Sum, std::map<std::size_t, double>>);
+    static_assert(!std::is_convertible_v<Sum, std::vector<std::string>>);
+    const std::deque<double> grown = lazy(raw) * 2.0;
+    EXPECT_EQ((std::deque<double>{2.0, 2.0, 2.0}), grown);
+
+    // operands and fixed-size targets of different lengths are rejected
+    const auto shorter = std::vector<double>{1.0, 2.0};
+    EXPECT_THROW(static_cast<void>(lazy(shorter) + lazy(a.vel)), std::length_error);
+    auto growing = std::vector<double>{1.0, 2.0, 3.0};
+    const auto diff = lazy(growing) - lazy(a.vel);
+    growing.push_back(4.0);
+    EXPECT_THROW(static_cast<void>(static_cast<std::vector<double>>(diff)), std::length_error);
+    EXPECT_THROW(a.dir = lazy(raw) * 2.0F, std::length_error);
+
+    // temporaries would dangle
+    static_assert(lazily_viewable<const std::vector<double>&>);
+    static_assert(!lazily_viewable<std::vector<double>>);
+}
+
+// clang-format off
+class Inventory
+{
+    std::vector<Counted> items_;
+
+    void validate()
+    {
+        ++validations;
+        if (items_.size() > 3) throw std::length_error("too many items");
+    }
+
+public:
+    int validations = 0;
+
+    property<const std::vector<Counted>&, std::vector<Counted>, modifiable> items
+    {
+        get_cref
+        {
+            return items_;
+        },
+        set_val
+        {
+            items_ = std::move(value);
+            validate();
+        },
+        modify_ref
+        {
+            mutate(items_);
+            validate();
+        }
+    };
+    auto_property<std::vector<int>> numbers;
+    property<int> count
+    {
+        get_val
+        {
+            return static_cast<int>(numbers().size());
+        },
+        set_val
+        {
+            numbers.modify([&](auto& v) { v.resize(static_cast<std::size_t>(value)); });
+        }
+    };
+};
+// clang-format on
+
+TEST(CppProperty, Modify)
+{
+    auto a = Inventory();
+    a.items.modify([](std::vector<Counted>& v) { v.reserve(4); });
+
+    Counted::copies = 0;
+    a.items.modify([](std::vector<Counted>& v) { v.emplace_back(1); });
+    a.items.modify([](std::vector<Counted>& v) { v.emplace_back(2); });
+    EXPECT_EQ(0, Counted::copies);
+    EXPECT_EQ(3, a.validations);
+    EXPECT_EQ(2U, a.items().size());
+
+    a.items.modify([](std::vector<Counted>& v) { v.emplace_back(3); });
+    EXPECT_THROW(a.items.modify([](std::vector<Counted>& v) { v.emplace_back(4); }), std::length_error);
+    EXPECT_EQ(5, a.validations);
+    // no rollback: the mutation stays applied when the validation throws
+    EXPECT_EQ(4U, a.items().size());
+
+    // auto-implemented properties are mutated in place
+    a.numbers.modify([](std::vector<int>& v) { v.reserve(8); });
+    const auto* data = a.numbers().data();
+    a.numbers.modify([](std::vector<int>& v) { v.push_back(1); });
+    EXPECT_EQ(data, a.numbers().data());
+
+    // other properties mutate a copy and assign it back
+    a.count.modify([](int& v) { v += 2; });
+    EXPECT_EQ(3, a.count());
+
+    auto deduced = property{[&a]() -> const auto& { return a.numbers(); }, [&a](std::vector<int> v) { a.numbers = v; },
+                            [&a](auto mutate) { a.numbers.modify(mutate); }};
+    static_assert(std::same_as<decltype(deduced), property<const std::vector<int>&, std::vector<int>, modifiable>>);
+    deduced.modify([](std::vector<int>& v) { v.clear(); });
+    EXPECT_TRUE(a.numbers().empty());
+}
+
+struct Resolution
+{
+    auto_property<int> width{640};
+    auto_property<int> height{480};
+    auto_property<int, get_only> depth{get, 24};
+};
+
+constexpr auto scaled_area(int scale)
+{
+    auto r = Resolution();
+    r.width = r.width * scale;
+    r.height = r.height * scale;
+    return r.width * r.height;
+}
+
+consteval auto accessor_round_trip()
+{
+    auto num = 1;
+    auto p = property<const int&>{get_auto{num}, set_auto{num}};
+    p = 2;
+    p *= 3;
+    auto q = property<int, set_only>{set_auto{num}};
+    q = p + 1;
+    return num;
+}
+
+TEST(CppProperty, Constexpr)
+{
+    static constexpr auto r = Resolution();
+    static_assert(r.width == 640);
+    static_assert(r.height() < r.width());
+    static_assert(r.depth == 24);
+    static_assert(scaled_area(2) == 1280 * 960);
+    static_assert(accessor_round_trip() == 7);
+    EXPECT_EQ(640, r.width);
+}
+
+// clang-format off
+class Inlined
+{
+    double num_ = 0;
+
+public:
+    inline_property<const double&, Inlined, get_self_cref { return self.num_; }, set_self_val
+    {
+        if (value < 0) throw std::invalid_argument("value must be >= 0");
+        self.num_ = value;
+    }> num{this};
+    inline_property<double, Inlined, get_self_val { return self.num_ * self.num_; }> square_num{this};
+};
+// clang-format on
+
+TEST(CppProperty, Inline)
+{
+    auto a = Inlined();
+    static_assert(sizeof(a.num) == sizeof(void*));
+    static_assert(std::same_as<const double&, decltype(a.num())>);
+    static_assert(!std::is_assignable_v<decltype(a.square_num)&, double>);
+
+    a.num = 2.0;
+    EXPECT_EQ(2.0, a.num());
+    a.num += 1.0;
+    EXPECT_EQ(3.0, a.num());
+    EXPECT_EQ(9.0, a.square_num());
+    EXPECT_THROW(a.num = -1.0, std::invalid_argument);
+    a.num = a.square_num;
+    EXPECT_EQ(9.0, a.num());
+}
+
+// clang-format off
+class Limits
+{
+    static inline int max_connections_ = 16;
+    static inline std::string name_ = "default";
+
+public:
+    static inline static_property<int, static_get_val { return max_connections_; }, static_set_val
+    {
+        if (value < 0) throw std::invalid_argument("value must be >= 0");
+        max_connections_ = value;
+    }> max_connections;
+    static inline static_property<const std::string&, static_get_cref { return name_; },
+                                  static_set_cref { name_ = value; }> name;
+    static inline static_property<int, static_get_val { return max_connections_ * 2; }> max_handles;
+
+    int id = 0;
+};
+// clang-format on
+
+TEST(CppProperty, Static)
+{
+    static_assert(sizeof(Limits) == sizeof(int));
+    static_assert(std::is_empty_v<decltype(Limits::max_connections)>);
+    static_assert(std::same_as<const std::string&, decltype(Limits::name())>);
+    static_assert(!std::is_assignable_v<decltype(Limits::max_handles)&, int>);
+
+    EXPECT_EQ(16, Limits::max_connections);
+    Limits::max_connections = 32;
+    Limits::max_connections += 8;
+    EXPECT_EQ(40, Limits::max_connections());
+    EXPECT_EQ(80, Limits::max_handles());
+    EXPECT_THROW(Limits::max_connections = -1, std::invalid_argument);
+    EXPECT_EQ(40, Limits::max_connections());
+
+    // instances share the class-level value
+    auto a = Limits();
+    auto b = Limits();
+    a.max_connections = 4;
+    EXPECT_EQ(4, b.max_connections());
+    Limits::max_connections = Limits::max_handles;
+    EXPECT_EQ(8, a.max_connections());
+
+    Limits::name = "custom";
+    EXPECT_EQ(6U, Limits::name->size());
+    EXPECT_EQ("custom", b.name());
+}
+
+class Figure
+{
+    double scale_ = 1.0;
+
+protected:
+    [[nodiscard]] virtual double get_area() const { return 0.0; }
+    [[nodiscard]] virtual const double& get_scale() const { return scale_; }
+    virtual void set_scale(double value)
+    {
+        if (value <= 0) throw std::invalid_argument("value must be > 0");
+        scale_ = value;
+    }
+
+public:
+    virtual_property<double, Figure, &Figure::get_area> area{this};
+    virtual_property<const double&, Figure, virtual_get(get_scale), virtual_set(set_scale)> scale{this};
+
+    Figure() = default;
+    Figure(const Figure&) = delete;
+    Figure(Figure&&) = delete;
+    Figure& operator=(const Figure&) = delete;
+    Figure& operator=(Figure&&) = delete;
+    virtual ~Figure() = default;
+};
+
+class Square final : public Figure
+{
+    double side_;
+    double get_area() const override { return side_ * side_ * scale() * scale(); }
+    void set_scale(double value) override { Figure::set_scale(value < 1.0 ? 1.0 : value); }
+
+public:
+    explicit Square(double side) : side_(side) {}
+};
+
+TEST(CppProperty, Virtual)
+{
+    static_assert(sizeof(Figure::area) == sizeof(void*));
+    static_assert(sizeof(Figure::scale) == sizeof(void*));
+    static_assert(std::same_as<const double&, decltype(std::declval<Figure&>().scale())>);
+    static_assert(!std::is_assignable_v<decltype(Figure::area)&, double>);
+
+    auto base = std::make_unique<Figure>();
+    EXPECT_EQ(0.0, base->area());
+    base->scale = 0.5;
+    EXPECT_EQ(0.5, base->scale());
+    EXPECT_THROW(base->scale = 0.0, std::invalid_argument);
+
+    // accessors dispatched to the overrides through the base property
+    std::unique_ptr<Figure> square = std::make_unique<Square>(3.0);
+    EXPECT_EQ(9.0, square->area());
+    square->scale = 0.5;
+    EXPECT_EQ(1.0, square->scale());
+    square->scale += 1.0;
+    EXPECT_EQ(2.0, square->scale());
+    EXPECT_EQ(36.0, square->area());
+    base->scale = square->scale;
+    EXPECT_EQ(2.0, base->scale());
+}
+
+enum class Team : std::uint8_t
+{
+    red,
+    green,
+    blue
+};
+
+class Entity
+{
+    using layout = cpp_property::packed_layout<std::uint16_t, cpp_property::packed_field<bool>,
+                                               cpp_property::packed_field<bool>, cpp_property::packed_field<Team, 2>,
+                                               cpp_property::packed_field<unsigned, 4>,
+                                               cpp_property::packed_field<int, 5>>;
+
+public:
+    layout::word flags;
+
+    auto visible() noexcept { return flags.field<0>(); }
+    auto selected() noexcept { return flags.field<1>(); }
+    auto team() noexcept { return flags.field<2>(); }
+    auto level() noexcept { return flags.field<3>(); }
+    auto delta() noexcept { return flags.field<4>(); }
+};
+
+TEST(CppProperty, Packed)
+{
+    static_assert(sizeof(Entity) == sizeof(std::uint16_t));
+    auto a = Entity();
+    EXPECT_EQ(0U, a.flags());
+
+    a.visible() = true;
+    a.team() = Team::blue;
+    a.level() = 9U;
+    a.delta() = -3;
+    EXPECT_TRUE(a.visible()());
+    EXPECT_FALSE(a.selected()());
+    EXPECT_EQ(Team::blue, a.team()());
+    EXPECT_EQ(9U, a.level()());
+    EXPECT_EQ(-3, a.delta()());
+
+    a.selected() = !a.visible();
+    a.level() += 3U;
+    ++a.level();
+    a.delta() -= 12;
+    a.visible() ^= true;
+    EXPECT_FALSE(a.visible()());
+    EXPECT_FALSE(a.selected()());
+    EXPECT_EQ(13U, a.level()());
+    EXPECT_EQ(-15, a.delta()());
+    EXPECT_EQ(Team::blue, a.team()());
+
+    // views of a const word are read-only
+    const auto& c = a.flags;
+    static_assert(!std::is_assignable_v<decltype(c.field<3>()), unsigned>);
+    EXPECT_EQ(13U, c.field<3>()());
+
+    // bulk access to all flags
+    const std::uint16_t all = a.flags;
+    a.flags = 0;
+    EXPECT_EQ(0U, a.level()());
+    a.flags = all;
+    EXPECT_EQ(13U, a.level()());
+
+    // values out of range of a field are rejected by an assert in debug builds
+    using Level = decltype(a.level());
+    using Delta = decltype(a.delta());
+    static_assert(Level::fits(15U) && !Level::fits(16U));
+    static_assert(Delta::fits(-16) && Delta::fits(15) && !Delta::fits(-17) && !Delta::fits(16));
+}
+
+struct Product
+{
+    cpp_property::interned_property<> category;
+    cpp_property::interned_property<> country{"JP"};
+};
+
+TEST(CppProperty, Interned)
+{
+    static_assert(sizeof(cpp_property::interned_property<>) == sizeof(void*));
+    auto products = std::vector<Product>(3);
+    EXPECT_TRUE(products[0].category().empty());
+    EXPECT_EQ(products[0].country, "JP");
+
+    auto name = std::string("electronics and household appliances");
+    products[0].category = name;
+    products[1].category = std::string_view(name);
+    products[2].category = "books";
+    static_assert(std::same_as<std::string_view, decltype(products[0].category())>);
+    EXPECT_EQ(products[0].category, "electronics and household appliances");
+    EXPECT_EQ(products[0].category.handle(), products[1].category.handle());
+    EXPECT_TRUE(products[0].category == products[1].category);
+    EXPECT_FALSE(products[0].category == products[2].category);
+    EXPECT_TRUE(products[0].country == products[2].country);
+
+    // views stay valid after reassignment
+    const auto view = products[0].category();
+    products[0].category = products[2].category;
+    EXPECT_EQ("electronics and household appliances", view);
+    EXPECT_EQ(products[2].category.handle(), products[0].category.handle());
+
+    // copies share the handle
+    const auto copy = products[1];
+    EXPECT_TRUE(copy.category == products[1].category);
+
+    // concurrent interning returns one handle per string
+    auto handles = std::vector<const std::string*>(4);
+    auto threads = std::vector<std::thread>();
+    for (std::size_t i = 0; i < handles.size(); ++i)
+        threads.emplace_back([&handles, i] {
+            auto p = cpp_property::interned_property<>();
+            for (auto n = 0; n < 1000; ++n) p = "tag-" + std::to_string(n);
+            handles[i] = p.handle();
+        });
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(handles[0], handles[3]);
+}
+
+struct Snapshot
+{
+    cpp_property::cow_property<std::vector<int>> samples{std::vector<int>{1, 2, 3}};
+    cpp_property::cow_property<int, std::size_t> version;
+};
+
+TEST(CppProperty, CopyOnWrite)
+{
+    auto a = Snapshot();
+    const auto* data = a.samples().data();
+
+    // copies share the value
+    auto b = a;
+    auto c = b;
+    EXPECT_EQ(3U, a.samples.use_count());
+    EXPECT_EQ(data, c.samples().data());
+
+    // the first write through modify() clones
+    b.samples.modify([](std::vector<int>& v) { v.push_back(4); });
+    EXPECT_EQ(2U, a.samples.use_count());
+    EXPECT_TRUE(b.samples.unique());
+    EXPECT_EQ(data, a.samples().data());
+    EXPECT_EQ(4U, b.samples().size());
+    EXPECT_EQ(3U, c.samples().size());
+
+    // assignment replaces a shared value without cloning it
+    c.samples = std::vector<int>{9};
+    EXPECT_TRUE(a.samples.unique());
+    EXPECT_EQ(std::vector<int>{9}, c.samples());
+    EXPECT_EQ(data, a.samples().data());
+
+    // compound operators
+    {
+        auto d = a;
+        d.version += 2;
+        ++d.version;
+        EXPECT_EQ(0, a.version());
+        EXPECT_EQ(3, d.version());
+    }
+
+    // writes to a unique value are in place
+    a.samples.modify([](std::vector<int>& v) { v[0] = 0; });
+    EXPECT_EQ(data, a.samples().data());
+
+    // concurrent copies and releases with the atomic reference count
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < 4; ++i)
+        threads.emplace_back([&a] {
+            for (auto n = 0; n < 1000; ++n)
+            {
+                auto copy = a.samples;
+                EXPECT_EQ(0, copy()[0]);
+            }
+        });
+    for (auto& t : threads) t.join();
+    EXPECT_TRUE(a.samples.unique());
+}
+
+struct Measurement
+{
+    cpp_property::optional_property<double> temperature;
+    cpp_property::optional_property<int, cpp_property::sentinel<-1>> count{3};
+    cpp_property::optional_property<const char*> label;
+};
+
+TEST(CppProperty, Optional)
+{
+    static_assert(sizeof(cpp_property::optional_property<double>) == sizeof(double));
+    static_assert(sizeof(cpp_property::optional_property<int, cpp_property::sentinel<-1>>) == sizeof(int));
+    static_assert(sizeof(cpp_property::optional_property<const char*>) == sizeof(const char*));
+
+    auto m = Measurement();
+    EXPECT_FALSE(m.temperature.has_value());
+    EXPECT_FALSE(m.label.has_value());
+    EXPECT_TRUE(m.count.has_value());
+    EXPECT_THROW(static_cast<void>(m.temperature()), std::bad_optional_access);
+    EXPECT_EQ(-273.15, m.temperature.value_or(-273.15));
+    EXPECT_EQ(std::nullopt, m.temperature.to_optional());
+
+    // comparisons do not read an unset value
+    EXPECT_TRUE(m.temperature == std::nullopt);
+    EXPECT_TRUE(std::nullopt == m.temperature);
+    EXPECT_FALSE(m.temperature == 20.5);
+    EXPECT_TRUE(20.5 != m.temperature);
+    EXPECT_TRUE(m.temperature == Measurement().temperature);
+    EXPECT_TRUE(m.count != std::nullopt);
+    EXPECT_TRUE(m.count == 3);
+    EXPECT_TRUE(3 == m.count);
+    EXPECT_FALSE(m.count != 3);
+
+    // and order an unset property before every value
+    EXPECT_TRUE(m.temperature < 20.5);
+    EXPECT_TRUE(-1000.0 > m.temperature);
+    EXPECT_FALSE(m.temperature >= -1000.0);
+    EXPECT_TRUE(m.temperature <= Measurement().temperature);
+    EXPECT_TRUE(m.temperature < m.count());
+    EXPECT_TRUE((m.temperature <=> std::nullopt) == 0);
+    EXPECT_TRUE(m.count > std::nullopt);
+    EXPECT_TRUE(m.count < 4);
+    EXPECT_TRUE(4 >= m.count);
+    EXPECT_TRUE((m.count <=> 3) == 0);
+    EXPECT_TRUE((2 <=> m.count) < 0);
+
+    m.temperature = 20.5;
+    m.temperature += 1.0;
+    EXPECT_TRUE(m.temperature.has_value());
+    EXPECT_EQ(21.5, m.temperature());
+    EXPECT_EQ(std::optional(21.5), m.temperature.to_optional());
+
+    ++m.count;
+    EXPECT_EQ(4, m.count());
+    m.count = std::nullopt;
+    EXPECT_FALSE(m.count.has_value());
+    EXPECT_THROW(m.count += 1, std::bad_optional_access);
+    EXPECT_EQ(0, m.count.value_or(0));
+    EXPECT_TRUE(m.count < Measurement().count);
+    EXPECT_THROW(static_cast<void>(m.count + 1), std::bad_optional_access);
+
+    m.label = "label";
+    EXPECT_EQ(std::string_view("label"), m.label());
+    m.label.reset();
+    EXPECT_EQ(nullptr, m.label.value_or(nullptr));
+}
+
+struct Shape
+{
+    cpp_property::journaled_property<double> x;
+    cpp_property::journaled_property<double> y;
+    cpp_property::journaled_property<int> color{0xffffff};
+};
+
+// clang-format off
+class Layer
+{
+    int opacity_ = 100;
+
+public:
+    cpp_property::property<int> opacity{
+        get_val { return opacity_; },
+        set_val { cpp_property::journal::record_write(opacity_); opacity_ = value; }};
+};
+// clang-format on
+
+TEST(CppProperty, Journal)
+{
+    auto shape = Shape();
+    auto layer = Layer();
+
+    // writes without an active journal are not recorded
+    shape.x = 1.0;
+    EXPECT_EQ(nullptr, cpp_property::journal::active());
+
+    auto history = cpp_property::journal(256);
+    {
+        const auto scope = cpp_property::journal::scope(history);
+        EXPECT_EQ(&history, cpp_property::journal::active());
+
+        shape.x = 2.0;
+        shape.y = 3.0;
+        history.commit();
+        shape.color = 0x000000;
+        layer.opacity = 50;
+        history.commit();
+        shape.x += 1.0;
+        shape.x.modify([](double& v) { v *= 2; });
+        history.commit();
+    }
+    EXPECT_EQ(nullptr, cpp_property::journal::active());
+    EXPECT_EQ(6.0, shape.x());
+
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(2.0, shape.x());
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(0xffffff, shape.color());
+    EXPECT_EQ(100, layer.opacity());
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(1.0, shape.x());
+    EXPECT_EQ(0.0, shape.y());
+    EXPECT_FALSE(history.undo());
+    EXPECT_FALSE(history.can_undo());
+
+    EXPECT_TRUE(history.redo());
+    EXPECT_EQ(2.0, shape.x());
+    EXPECT_EQ(3.0, shape.y());
+    EXPECT_TRUE(history.redo());
+    EXPECT_EQ(0x000000, shape.color());
+    EXPECT_EQ(50, layer.opacity());
+    EXPECT_TRUE(history.undo());
+
+    // a new write discards the undone steps
+    {
+        const auto scope = cpp_property::journal::scope(history);
+        shape.y = 4.0;
+    }
+    EXPECT_FALSE(history.can_redo());
+    EXPECT_FALSE(history.redo());
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(3.0, shape.y());
+    EXPECT_EQ(0xffffff, shape.color());
+
+    // the arena is reused after truncation
+    const auto capacity = history.capacity();
+    for (int i = 0; i < 3; ++i)
+    {
+        history.clear();
+        EXPECT_FALSE(history.can_undo());
+        const auto scope = cpp_property::journal::scope(history);
+        for (int j = 0; j < 100; ++j)
+        {
+            shape.color = j;
+            history.commit();
+        }
+        EXPECT_EQ(99, shape.color());
+        for (int j = 0; j < 100; ++j) EXPECT_TRUE(history.undo());
+        EXPECT_EQ(0xffffff, shape.color());
+    }
+    EXPECT_LE(capacity, history.capacity());
+    const auto warmed = history.capacity();
+    history.clear();
+    {
+        const auto scope = cpp_property::journal::scope(history);
+        for (int j = 0; j < 100; ++j) shape.color = j;
+    }
+    EXPECT_EQ(warmed, history.capacity());
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(0xffffff, shape.color());
+}
+
+#if __has_include(<sys/mman.h>)
+struct SessionState
+{
+    double position;
+    int count;
+};
+
+class Session
+{
+    cpp_property::mapped_storage<SessionState> storage_;
+
+public:
+    explicit Session(const std::filesystem::path& path) : storage_(path) {}
+
+    auto_property<double&> position{storage_->position};
+    auto_property<int&> count{storage_->count};
+
+    [[nodiscard]] bool recovered() const { return storage_.recovered(); }
+    void flush() const { storage_.flush(); }
+};
+
+TEST(CppProperty, Mapped)
+{
+    const auto path = std::filesystem::temp_directory_path() / "cpp_property_mapped_test.bin";
+    std::filesystem::remove(path);
+    {
+        auto s = Session(path);
+        EXPECT_FALSE(s.recovered());
+        EXPECT_EQ(0.0, s.position());
+        EXPECT_EQ(0, s.count());
+        s.position = 1.5;
+        s.count = s.count + 3;
+        s.flush();
+    }
+    {
+        auto s = Session(path);
+        EXPECT_TRUE(s.recovered());
+        EXPECT_EQ(1.5, s.position());
+        EXPECT_EQ(3, s.count());
+        s.count = s.count + 1;
+    }
+    EXPECT_EQ(4, Session(path).count());
+
+    // moved-from storage has nothing to flush
+    {
+        auto from = cpp_property::mapped_storage<SessionState>(path);
+        const auto to = std::move(from);
+        EXPECT_NO_THROW(from.flush());  // NOLINT
+        EXPECT_NO_THROW(to.flush());
+    }
+
+    // the header rejects other versions and layouts
+    EXPECT_THROW((cpp_property::mapped_storage<SessionState, 2>(path)), std::runtime_error);
+    EXPECT_THROW((cpp_property::mapped_storage<double>(path)), std::runtime_error);
+    EXPECT_THROW(Session(path / "missing" / "file.bin"), std::system_error);
+    std::filesystem::remove(path);
+}
+#endif
+
+#if __has_include(<sys/mman.h>)
+struct Extent
+{
+    std::int64_t begin;
+    std::int64_t end;
+    std::int64_t step;
+};
+
+struct StatusBlock
+{
+    cpp_property::shm_cell<double> load;
+    cpp_property::shm_cell<std::uint64_t> requests;
+    cpp_property::shm_cell<Extent> extent;
+};
+
+class Status
+{
+    cpp_property::shm_segment<StatusBlock> segment_;
+
+public:
+    explicit Status(const std::string& name) : segment_(name) {}
+
+    cpp_property::shm_property<double> load{segment_->load};
+    cpp_property::shm_property<std::uint64_t> requests{segment_->requests};
+    cpp_property::shm_property<Extent> extent{segment_->extent};
+
+    [[nodiscard]] bool created() const { return segment_.created(); }
+};
+
+TEST(CppProperty, SharedMemory)
+{
+    static_assert(cpp_property::shm_cell<double>::lock_free);
+    static_assert(!cpp_property::shm_cell<Extent>::lock_free);
+
+    const auto name = "/cpp_property_test_" + std::to_string(::getpid());
+    cpp_property::shm_segment<StatusBlock>::remove(name);
+    auto status = Status(name);
+    EXPECT_TRUE(status.created());
+    EXPECT_EQ(0.0, status.load());
+
+    constexpr auto writers = 2;
+    constexpr auto iterations = 20000;
+    auto children = std::vector<pid_t>();
+    for (auto w = 0; w < writers; ++w)
+    {
+        if (const auto pid = ::fork(); pid == 0)
+        {
+            // another process opens the segment by name
+            auto child = Status(name);
+            auto ok = !child.created();
+            child.load = 0.5;
+            for (auto i = 1; i <= iterations; ++i)
+            {
+                child.requests.modify([](std::uint64_t& n) { ++n; });
+                child.requests += 3;
+                child.requests--;
+                child.extent = Extent{i, -i, 1};
+            }
+            ::_exit(ok ? 0 : 1);
+        }
+        else
+        {
+            children.push_back(pid);
+        }
+    }
+
+    // readers never observe a torn value
+    auto torn = 0;
+    for (auto i = 0; i < iterations; ++i)
+    {
+        const auto e = status.extent();
+        if (e.begin != -e.end || (e.step != 0 && e.step != 1)) ++torn;
+    }
+    for (const auto pid : children)
+    {
+        auto wstatus = 0;
+        ::waitpid(pid, &wstatus, 0);
+        EXPECT_TRUE(WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0);
+    }
+    EXPECT_EQ(0, torn);
+    EXPECT_EQ(0.5, status.load());
+    EXPECT_EQ(0.75, status.load += 0.25);
+    EXPECT_EQ(std::uint64_t{3 * writers * iterations}, status.requests());
+    EXPECT_EQ(std::uint64_t{3 * writers * iterations + 5}, status.requests += 5);
+    EXPECT_EQ(std::uint64_t{3 * writers * iterations + 5}, status.requests--);
+    EXPECT_EQ(std::uint64_t{3 * writers * iterations + 5}, ++status.requests);
+    EXPECT_EQ(std::uint64_t{6 * writers * iterations + 10}, status.requests *= 2);
+    EXPECT_EQ(iterations, status.extent().begin);
+
+    // a throwing update releases the lock and keeps the value
+    const auto reject = [](Extent& e) {
+        e.begin = 0;
+        throw std::runtime_error("rejected");
+    };
+    EXPECT_THROW(status.extent.modify(reject), std::runtime_error);
+    EXPECT_EQ(iterations, status.extent().begin);
+
+    // a writer which dies while holding the lock is reported instead of blocking readers forever
+    if (const auto pid = ::fork(); pid == 0)
+    {
+        auto child = Status(name);
+        child.extent.modify([](Extent&) { ::_exit(0); });
+        ::_exit(1);
+    }
+    else
+    {
+        ::waitpid(pid, nullptr, 0);
+    }
+    EXPECT_THROW(static_cast<void>(status.extent()), std::runtime_error);
+    cpp_property::shm_segment<StatusBlock>::remove(name);
+
+    // so is a creator which dies before initializing the segment
+    const auto fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);  // NOLINT
+    ASSERT_GE(fd, 0);
+    ::close(fd);
+    EXPECT_THROW(cpp_property::shm_segment<StatusBlock>(name, std::chrono::milliseconds(10)), std::runtime_error);
+    cpp_property::shm_segment<StatusBlock>::remove(name);
+}
+#endif
+
+// clang-format off
+class Invoice
+{
+    double tax_rate_ = 0.1;
+
+public:
+    auto_property<double> price{100.0};
+    auto_property<int> quantity{1};
+    auto_property<double> subtotal;
+    property<double> tax{
+        get_val { return subtotal() * tax_rate_; },
+        set_val { tax_rate_ = value / subtotal(); }};
+    auto_property<double> discount;
+    auto_property<double> total;
+};
+// clang-format on
+
+TEST(CppProperty, Binding)
+{
+    auto inv = Invoice();
+    auto graph = cpp_property::binding_graph();
+    auto total_evaluations = 0;
+    auto inconsistent = 0;
+
+    // diamond: subtotal -> {discount, total}, discount -> total
+    graph.bind(inv.subtotal, [](double p, int q) { return p * q; }, inv.price, inv.quantity);
+    graph.bind(inv.discount, [](double s) { return s >= 500.0 ? s * 0.1 : 0.0; }, inv.subtotal);
+    graph.bind(
+        inv.total,
+        [&](double s, double d) {
+            ++total_evaluations;
+            if (std::abs(d - (s >= 500.0 ? s * 0.1 : 0.0)) > 1e-9) ++inconsistent;
+            return s - d;
+        },
+        inv.subtotal, inv.discount);
+    EXPECT_EQ(100.0, inv.subtotal());
+    EXPECT_EQ(100.0, inv.total());
+
+    total_evaluations = 0;
+    graph.set(inv.quantity, 10);
+    EXPECT_EQ(1000.0, inv.subtotal());
+    EXPECT_EQ(100.0, inv.discount());
+    EXPECT_EQ(900.0, inv.total());
+    EXPECT_EQ(1, total_evaluations);
+
+    // several changes in one wave
+    total_evaluations = 0;
+    graph.batch([&] {
+        inv.price = 20.0;
+        inv.quantity = 2;
+        graph.notify(inv.price);
+        graph.notify(inv.quantity);
+    });
+    EXPECT_EQ(40.0, inv.total());
+    EXPECT_EQ(1, total_evaluations);
+
+    // an unchanged value stops the propagation
+    total_evaluations = 0;
+    graph.set(inv.price, 20.0);
+    EXPECT_EQ(0, total_evaluations);
+    EXPECT_EQ(0, inconsistent);
+
+    // function-backed properties bind through their getter and setter
+    graph.bind(inv.tax, [](double t) { return t * 0.2; }, inv.total);
+    EXPECT_DOUBLE_EQ(8.0, inv.tax());
+
+    EXPECT_THROW(graph.bind(inv.subtotal, [](double t) { return t; }, inv.total), std::invalid_argument);
+    EXPECT_THROW(graph.bind(inv.price, [](double t) { return t; }, inv.total), std::invalid_argument);
+    EXPECT_THROW(graph.bind(inv.price, [](double p) { return p; }, inv.price), std::invalid_argument);
+
+    graph.unbind(inv.total);
+    graph.set(inv.price, 30.0);
+    EXPECT_EQ(60.0, inv.subtotal());
+    EXPECT_EQ(40.0, inv.total());
+    graph.bind(inv.price, [](double t) { return t; }, inv.total);
+    EXPECT_EQ(40.0, inv.price());
+}
+
+TEST(CppProperty, BindingDiamonds)
+{
+    // a chain of diamonds x[i] -> {b[i], c[i]} -> x[i + 1] has 2^layers paths; binding it from the bottom up
+    // makes every cycle check and rank update walk the whole rest of the chain
+    constexpr auto layers = std::size_t{40};
+    auto x = std::array<auto_property<int>, layers + 1>();
+    auto b = std::array<auto_property<int>, layers>();
+    auto c = std::array<auto_property<int>, layers>();
+    auto graph = cpp_property::binding_graph();
+    for (auto i = layers; i-- > 0;)
+    {
+        graph.bind(x[i + 1], [](int l, int r) { return l + r; }, b[i], c[i]);
+        graph.bind(b[i], [](int v) { return v + 1; }, x[i]);
+        graph.bind(c[i], [](int v) { return -v; }, x[i]);
+    }
+    graph.set(x[0], 5);
+    EXPECT_EQ(1, x[layers]());
+    EXPECT_THROW(graph.bind(x[0], [](int v) { return v; }, x[layers]), std::invalid_argument);
+}
+
+TEST(CppProperty, BindingThrows)
+{
+    auto in = auto_property<int>(1);
+    auto mid = auto_property<int>();
+    auto copy = auto_property<int>();
+    auto sum = auto_property<int>();
+    auto other = auto_property<int>();
+    auto sink = auto_property<int>();
+    auto graph = cpp_property::binding_graph();
+    auto sum_evaluations = 0;
+    graph.bind(
+        mid,
+        [](int v) {
+            if (v < 0) throw std::domain_error("negative");
+            return v;
+        },
+        in);
+    graph.bind(copy, [](int v) { return v; }, in);
+    graph.bind(
+        sum,
+        [&](int l, int r) {
+            ++sum_evaluations;
+            return l + r;
+        },
+        in, copy);
+    graph.bind(sink, [](int v) { return v; }, other);
+
+    // a throwing evaluation drops the rest of its wave, which does not leak into the next one
+    sum_evaluations = 0;
+    EXPECT_THROW(graph.set(in, -1), std::domain_error);
+    graph.set(other, 1);
+    EXPECT_EQ(1, sink());
+    EXPECT_EQ(0, sum_evaluations);
+
+    graph.set(in, 3);
+    EXPECT_EQ(3, mid());
+    EXPECT_EQ(6, sum());
+    EXPECT_EQ(1, sum_evaluations);
+}
+
+auto queue_depth_channel = cpp_property::telemetry_channel("Queue::depth");
+
+// clang-format off
+class Queue
+{
+    int depth_ = 0;
+
+public:
+    property<int> depth
+    {
+        get_val { return depth_; },
+        cpp_property::sampled(queue_depth_channel, set_val { depth_ = value; })
+    };
+};
+// clang-format on
+
+TEST(CppProperty, Telemetry)
+{
+    constexpr auto THREADS = 3;
+    constexpr auto ITERATIONS = 1000;
+    static_assert(ITERATIONS < cpp_property::telemetry_ring::capacity);
+
+    cpp_property::drain_telemetry([](const cpp_property::telemetry_sample&) {});
+    {
+        auto threads = std::vector<std::jthread>();
+        for (auto t = 0; t < THREADS; ++t)
+            threads.emplace_back([] {
+                auto q = Queue();
+                for (auto i = 0; i < ITERATIONS; ++i) q.depth = i;
+            });
+    }
+
+    // samples of one thread are in order
+    auto count = 0;
+    auto sum = 0.0;
+    auto ordered = true;
+    auto previous = cpp_property::telemetry_sample{0, nullptr, 0.0};
+    const auto drained = cpp_property::drain_telemetry([&](const cpp_property::telemetry_sample& s) {
+        EXPECT_EQ(&queue_depth_channel, s.channel);
+        EXPECT_STREQ("Queue::depth", s.channel->name());
+        if (s.value > 0.5)
+            ordered = ordered && std::abs(s.value - previous.value - 1.0) < 1e-9 &&
+                      s.timestamp >= previous.timestamp;
+        previous = s;
+        sum += s.value;
+        ++count;
+    });
+    EXPECT_EQ(static_cast<std::size_t>(THREADS * ITERATIONS), drained);
+    EXPECT_EQ(THREADS * ITERATIONS, count);
+    EXPECT_DOUBLE_EQ(THREADS * (ITERATIONS - 1) * ITERATIONS / 2.0, sum);
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(0U, cpp_property::drain_telemetry([](const cpp_property::telemetry_sample&) {}));
+
+    // a full ring drops new samples instead of blocking
+    queue_depth_channel.enable(false);
+    auto q = Queue();
+    q.depth = 1;
+    EXPECT_EQ(0U, cpp_property::drain_telemetry([](const cpp_property::telemetry_sample&) {}));
+    queue_depth_channel.enable();
+    const auto dropped = cpp_property::telemetry_dropped();
+    for (std::size_t i = 0; i < cpp_property::telemetry_ring::capacity + 10; ++i) q.depth = 2;
+    EXPECT_EQ(dropped + 10, cpp_property::telemetry_dropped());
+    EXPECT_EQ(cpp_property::telemetry_ring::capacity,
+              cpp_property::drain_telemetry([](const cpp_property::telemetry_sample&) {}));
+
+    // at most max_rings threads hold a ring at once (this one included); samples of further threads are dropped
+    {
+        constexpr auto holders = static_cast<std::ptrdiff_t>(cpp_property::telemetry_ring::max_rings - 1);
+        auto ready = std::latch(holders);
+        auto done = std::latch(1);
+        auto threads = std::vector<std::jthread>();
+        for (auto t = 0; t < holders; ++t)
+            threads.emplace_back([&] {
+                auto holder = Queue();
+                holder.depth = 1;
+                ready.count_down();
+                done.wait();
+            });
+        ready.wait();
+        const auto before = cpp_property::telemetry_dropped();
+        std::jthread([] {
+            auto extra = Queue();
+            extra.depth = 1;
+        }).join();
+        EXPECT_EQ(before + 1, cpp_property::telemetry_dropped());
+        done.count_down();
+    }
+
+    // the callback runs after the rings are emptied and may drain again
+    auto nested = std::size_t{0};
+    EXPECT_EQ(static_cast<std::size_t>(cpp_property::telemetry_ring::max_rings - 1),
+              cpp_property::drain_telemetry([&](const cpp_property::telemetry_sample&) {
+                  nested += cpp_property::drain_telemetry([](const cpp_property::telemetry_sample&) {});
+              }));
+    EXPECT_EQ(0U, nested);
+}
+
+// clang-format off
+class Quote
+{
+    double price_ = 0;
+    std::string venue_;
+
+public:
+    int price_updates = 0;
+    int venue_updates = 0;
+
+    explicit Quote(cpp_property::coalescer& feed)
+        : price{
+              get_val { return price_; },
+              cpp_property::coalesced<double>(feed, set_val { price_ = value; ++price_updates; })},
+          venue{
+              get_cref { return venue_; },
+              cpp_property::coalesced<std::string>(feed, set_cref { venue_ = value; ++venue_updates; })}
+    {
+    }
+    Quote(const Quote&) = delete;
+    Quote(Quote&&) = delete;
+    Quote& operator=(const Quote&) = delete;
+    Quote& operator=(Quote&&) = delete;
+    ~Quote() = default;
+
+    property<double> price;
+    property<const std::string&> venue;
+};
+// clang-format on
+
+TEST(CppProperty, Coalesce)
+{
+    auto feed = cpp_property::coalescer();
+    auto q = Quote(feed);
+
+    // writes are staged, the setter runs once per flush with the latest value
+    for (auto i = 1; i <= 1000; ++i) q.price = i * 0.5;
+    q.venue = "XNYS";
+    q.venue = "XNAS";
+    EXPECT_EQ(0.0, q.price());
+    EXPECT_EQ(0, q.price_updates);
+    EXPECT_EQ(2U, feed.flush());
+    EXPECT_EQ(500.0, q.price());
+    EXPECT_EQ("XNAS", q.venue());
+    EXPECT_EQ(1, q.price_updates);
+    EXPECT_EQ(1, q.venue_updates);
+    EXPECT_EQ(0U, feed.flush());
+
+    // at most once per interval
+    auto throttled = cpp_property::coalescer(std::chrono::hours(1));
+    auto r = Quote(throttled);
+    r.price = 1.0;
+    EXPECT_EQ(1U, throttled.poll());
+    r.price = 2.0;
+    EXPECT_EQ(0U, throttled.poll());
+    EXPECT_EQ(1.0, r.price());
+    EXPECT_EQ(1U, throttled.flush());
+    EXPECT_EQ(2.0, r.price());
+
+    // producers on several threads, setters on this one
+    {
+        auto running = std::atomic<int>(4);
+        auto threads = std::vector<std::jthread>();
+        for (auto t = 0; t < 4; ++t)
+            threads.emplace_back([&q, &running, t] {
+                for (auto i = 0; i < 10000; ++i) q.price = t + 10.0;
+                --running;
+            });
+        while (running > 0) feed.poll();
+    }
+    feed.flush();
+    EXPECT_LE(10.0, q.price());
+    EXPECT_GE(13.0, q.price());
+    EXPECT_GE(q.price_updates, 2);
+    EXPECT_LE(q.price_updates, 1 + 40000);
+}
+
+struct Connection
+{
+    cpp_property::owned_property<int> connections;
+    cpp_property::owned_property<std::string> state{std::string("idle")};
+    cpp_property::owned_property<std::vector<int>> events;
+};
+
+TEST(CppProperty, Owned)
+{
+    constexpr auto THREADS = 4;
+    constexpr auto ITERATIONS = 1000;
+
+    auto s = Connection();
+    EXPECT_TRUE(s.connections.on_owner_thread());
+
+    // the owner writes directly
+    static_assert(std::is_void_v<decltype(s.connections += 2)>);
+    s.connections += 2;
+    s.state = "open";
+    EXPECT_EQ(2, s.connections());
+    EXPECT_EQ("open", s.state());
+    EXPECT_EQ(0U, s.connections.drain());
+
+    // other threads enqueue, the owner applies while they run
+    auto running = std::atomic<int>(THREADS);
+    auto applied = std::size_t{0};
+    {
+        auto threads = std::vector<std::jthread>();
+        for (auto t = 0; t < THREADS; ++t)
+            threads.emplace_back([&s, &running, t] {
+                EXPECT_FALSE(s.connections.on_owner_thread());
+                for (auto i = 0; i < ITERATIONS; ++i)
+                {
+                    // compound operators are read-modify-writes enqueued like modify
+                    if (i % 2 == 0)
+                        s.connections += 1;
+                    else
+                        ++s.connections;
+                    s.events.modify([t, i](std::vector<int>& v) { v.push_back(t * ITERATIONS + i); });
+                }
+                s.state = "closing";
+                --running;
+            });
+        while (running > 0)
+        {
+            applied += s.connections.drain();
+            s.events.drain();
+        }
+    }
+    applied += s.connections.drain();
+    s.events.drain();
+    s.state.drain();
+
+    EXPECT_EQ(static_cast<std::size_t>(THREADS * ITERATIONS), applied);
+    EXPECT_EQ(2 + THREADS * ITERATIONS, s.connections());
+    EXPECT_EQ("closing", s.state());
+
+    // writes of one thread are applied in their order
+    ASSERT_EQ(static_cast<std::size_t>(THREADS * ITERATIONS), s.events().size());
+    auto last = std::vector<int>(THREADS, -1);
+    for (const auto e : s.events())
+    {
+        EXPECT_LT(last[static_cast<std::size_t>(e / ITERATIONS)], e);
+        last[static_cast<std::size_t>(e / ITERATIONS)] = e;
+    }
+
+    // pending writes are discarded with the property
+    {
+        auto p = cpp_property::owned_property<std::string>();
+        std::jthread([&p] { p = std::string(100, 'x'); }).join();
+    }
+}
 // NOLINTEND